@@ -0,0 +1,719 @@
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "vindex.h"
+
+using namespace std;
+
+struct Record {
+   int id;
+   int score;
+
+   Record(): id(0), score(0) {}
+
+   Record(int id, int score): id(id), score(score) {}
+
+   bool operator<(const Record& other) const { return id < other.id; }
+};
+
+ostream& operator<<(ostream& os, const Record& r) {
+   return os << "(" << r.id << "," << r.score << ")";
+}
+
+struct ScoreCmp: public IComparator<Record> {
+   bool operator==(const IComparator<Record>& other) const override {
+      return dynamic_cast<const ScoreCmp*>(&other) != nullptr;
+   }
+
+   bool lt(const Record& a, const Record& b) const override {
+      return a.score < b.score;
+   }
+};
+
+// Orders records by a seeded hash of the id, so each seed registers a 
+// distinct head with its own effectively random order.
+struct HashCmp: public IComparator<Record> {
+   unsigned seed;
+
+   explicit HashCmp(unsigned seed): seed(seed) {}
+
+   bool operator==(const IComparator<Record>& other) const override {
+      const HashCmp* cmp = dynamic_cast<const HashCmp*>(&other);
+      return cmp && cmp->seed == seed;
+   }
+
+   bool lt(const Record& a, const Record& b) const override {
+      return mix(a.id) < mix(b.id);
+   }
+
+   unsigned mix(int id) const {
+      unsigned h = static_cast<unsigned>(id) * 2654435761u ^ seed;
+      return h ^ (h >> 15);
+   }
+};
+
+struct Account {
+   string name;
+   int balance;
+
+   Account(const string& name, int balance): name(name), balance(balance) {}
+
+   bool operator<(const Account& other) const { return name < other.name; }
+};
+
+ostream& operator<<(ostream& os, const Account& a) {
+   return os << "(" << a.name << "," << a.balance << ")";
+}
+
+struct Document {
+   int id;
+   string body;
+   vector<int> tags;
+
+   Document(int id, const string& body, const vector<int>& tags): 
+      id(id), body(body), tags(tags) {}
+
+   bool operator<(const Document& other) const { return id < other.id; }
+};
+
+ostream& operator<<(ostream& os, const Document& d) {
+   return os << d.id;
+}
+
+typedef Vindex<int, Record> RecordVindex;
+typedef Vindex<int, Record, ScoreCmp> StaticRecordVindex;
+typedef chrono::steady_clock Clock;
+
+static double elapsed_ns(Clock::time_point start) {
+   return chrono::duration<double, nano>(Clock::now() - start).count();
+}
+
+static vector<int> shuffled_keys(size_t n, unsigned seed) {
+   vector<int> keys(n);
+   for (size_t i = 0; i < n; ++i)
+      keys[i] = static_cast<int>(i);
+   shuffle(keys.begin(), keys.end(), mt19937(seed));
+   return keys;
+}
+
+static void bench_scaling() {
+   cout << "scaling: per-op cost of insert/remove against log2(n)" << endl;
+   cout << setw(10) << "n"
+      << setw(8) << "log2n"
+      << setw(14) << "insert ns/op"
+      << setw(14) << "remove ns/op"
+      << setw(18) << "insert ns/log2n"
+      << setw(18) << "remove ns/log2n" << endl;
+
+   for (size_t n = 1 << 10; n <= (1 << 20); n <<= 2) {
+      vector<int> keys = shuffled_keys(n, 42);
+      RecordVindex vin(make_extractor(Record, id));
+      vin.push_comparator(ScoreCmp());
+
+      Clock::time_point start = Clock::now();
+      for (size_t i = 0; i < n; ++i)
+         vin.insert(Record(keys[i], keys[n - i - 1]));
+      double insert_ns = elapsed_ns(start) / n;
+
+      const size_t samples = 256;
+      vector<Record> removed;
+      removed.reserve(samples);
+      for (size_t i = 0; i < samples; ++i)
+         removed.push_back(vin.at(keys[i * (n / samples)]));
+
+      start = Clock::now();
+      for (size_t i = 0; i < samples; ++i)
+         vin.remove(removed[i].id);
+      double remove_ns = elapsed_ns(start) / samples;
+
+      double lg = log2(static_cast<double>(n));
+      cout << fixed << setprecision(1)
+         << setw(10) << n
+         << setw(8) << lg
+         << setw(14) << insert_ns
+         << setw(14) << remove_ns
+         << setw(18) << insert_ns / lg
+         << setw(18) << remove_ns / lg << endl;
+   }
+   cout << endl;
+}
+
+static void bench_churn() {
+   const size_t live = 1 << 20;
+   const size_t ops = 1 << 18;
+   cout << "churn: remove/insert pairs at " << live << " live entries" << endl;
+
+   vector<int> keys = shuffled_keys(live, 7);
+   RecordVindex vin(make_extractor(Record, id));
+   vin.push_comparator(ScoreCmp());
+   for (size_t i = 0; i < live; ++i)
+      vin.insert(Record(keys[i], keys[live - i - 1]));
+
+   mt19937 rng(11);
+   Clock::time_point start = Clock::now();
+   for (size_t i = 0; i < ops; ++i) {
+      size_t victim = rng() % live;
+      vin.remove(keys[victim]);
+      keys[victim] = static_cast<int>(live + i);
+      vin.insert(Record(keys[victim], static_cast<int>(rng() % live)));
+   }
+   double pair_ns = elapsed_ns(start) / ops;
+
+   cout << fixed << setprecision(1)
+      << setw(14) << "ns/pair" << setw(14) << "pairs/s" << endl
+      << setw(14) << pair_ns << setw(14) << 1e9 / pair_ns << endl << endl;
+}
+
+static void bench_find() {
+   cout << "find: positioned find() latency against n" << endl;
+   cout << setw(10) << "n" << setw(14) << "INORDER ns" 
+      << setw(14) << "score ns" << endl;
+
+   for (size_t n = 1 << 10; n <= (1 << 20); n <<= 2) {
+      vector<int> keys = shuffled_keys(n, 42);
+      RecordVindex vin(make_extractor(Record, id));
+      vin.push_comparator(ScoreCmp());
+      for (size_t i = 0; i < n; ++i)
+         vin.insert(Record(keys[i], keys[n - i - 1]));
+
+      const size_t lookups = 1 << 14;
+      long sum = 0;
+      Clock::time_point start = Clock::now();
+      for (size_t i = 0; i < lookups; ++i)
+         sum += vin.find(keys[i % n], OrderType::INORDER)->id;
+      double default_ns = elapsed_ns(start) / lookups;
+
+      start = Clock::now();
+      for (size_t i = 0; i < lookups; ++i)
+         sum += vin.find(keys[i % n], OrderType::INORDER, ScoreCmp())->id;
+      double score_ns = elapsed_ns(start) / lookups;
+      if (sum < 0)
+         cout << sum;
+
+      cout << fixed << setprecision(1)
+         << setw(10) << n 
+         << setw(14) << default_ns 
+         << setw(14) << score_ns << endl;
+   }
+   cout << endl;
+}
+
+static void bench_scan() {
+   cout << "scan: full forward scan throughput in Mnodes/s" << endl;
+   const OrderType::OrderType orders[] = { 
+      OrderType::INORDER, OrderType::PREORDER, OrderType::POSTORDER, 
+      OrderType::BREADTHFIRST, OrderType::INSERTION 
+   };
+   cout << setw(10) << "n" << setw(12) << "INORDER" << setw(12) << "PREORDER"
+      << setw(12) << "POSTORDER" << setw(14) << "BREADTHFIRST" 
+      << setw(12) << "INSERTION" << endl;
+
+   for (size_t n = 1 << 10; n <= (1 << 20); n <<= 2) {
+      vector<int> keys = shuffled_keys(n, 42);
+      RecordVindex vin(make_extractor(Record, id));
+      for (size_t i = 0; i < n; ++i)
+         vin.insert(Record(keys[i], 0));
+
+      cout << setw(10) << n;
+      for (size_t o = 0; o < sizeof(orders) / sizeof(orders[0]); ++o) {
+         const size_t rounds = (1 << 22) / n + 1;
+         long sum = 0;
+         Clock::time_point start = Clock::now();
+         for (size_t r = 0; r < rounds; ++r)
+            for (auto it = vin.cbegin(orders[o]); it != vin.cend(); ++it)
+               sum += it->id;
+         double ns = elapsed_ns(start);
+         if (sum < 0)
+            cout << sum;
+         cout << fixed << setprecision(1) 
+            << setw(orders[o] == OrderType::BREADTHFIRST ? 14 : 12) 
+            << rounds * n / ns * 1e3;
+      }
+      cout << endl;
+   }
+   cout << endl;
+}
+
+static void bench_at() {
+   cout << "at: at() latency against n, with and without reserve()" << endl;
+   cout << setw(10) << "n" << setw(14) << "insert ns" 
+      << setw(18) << "reserved ins ns" << setw(14) << "at ns" << endl;
+
+   for (size_t n = 1 << 10; n <= (1 << 20); n <<= 2) {
+      vector<int> keys = shuffled_keys(n, 42);
+      RecordVindex vin(make_extractor(Record, id));
+      Clock::time_point start = Clock::now();
+      for (size_t i = 0; i < n; ++i)
+         vin.insert(Record(keys[i], 0));
+      double insert_ns = elapsed_ns(start) / n;
+
+      RecordVindex reserved(make_extractor(Record, id));
+      reserved.reserve(n);
+      start = Clock::now();
+      for (size_t i = 0; i < n; ++i)
+         reserved.insert(Record(keys[i], 0));
+      double reserved_ns = elapsed_ns(start) / n;
+
+      const size_t lookups = 1 << 18;
+      long sum = 0;
+      start = Clock::now();
+      for (size_t i = 0; i < lookups; ++i)
+         sum += vin.at(keys[(i * 7919) % n]).id;
+      double at_ns = elapsed_ns(start) / lookups;
+      if (sum < 0)
+         cout << sum;
+
+      cout << fixed << setprecision(1)
+         << setw(10) << n << setw(14) << insert_ns 
+         << setw(18) << reserved_ns << setw(14) << at_ns << endl;
+   }
+   cout << endl;
+}
+
+static void bench_ingest() {
+   const size_t n = 1 << 18;
+   cout << "ingest: " << n << " records with a 256-byte body and 16 tags" 
+      << endl;
+   const string body(256, 'x');
+   const vector<int> tags(16, 7);
+   vector<int> keys = shuffled_keys(n, 42);
+
+   auto vin = make_vindex(Document, id);
+   Clock::time_point start = Clock::now();
+   for (size_t i = 0; i < n; ++i) {
+      Document doc(keys[i], body, tags);
+      vin.insert(doc);
+   }
+   double copy_ns = elapsed_ns(start) / n;
+
+   auto moved = make_vindex(Document, id);
+   start = Clock::now();
+   for (size_t i = 0; i < n; ++i)
+      moved.insert(Document(keys[i], body, tags));
+   double move_ns = elapsed_ns(start) / n;
+
+   auto emplaced = make_vindex(Document, id);
+   start = Clock::now();
+   for (size_t i = 0; i < n; ++i)
+      emplaced.emplace(keys[i], body, tags);
+   double emplace_ns = elapsed_ns(start) / n;
+
+   cout << fixed << setprecision(1)
+      << setw(14) << "insert(T&)" << setw(14) << "insert(T&&)" 
+      << setw(14) << "emplace" << endl
+      << setw(14) << copy_ns << setw(14) << move_ns 
+      << setw(14) << emplace_ns << " ns/op" << endl << endl;
+}
+
+template <typename VindexTy>
+static void time_insert_seek(
+   VindexTy& vin, const vector<int>& keys, double* insert_ns, 
+   double* seek_ns) {
+   const size_t n = keys.size();
+   Clock::time_point start = Clock::now();
+   for (size_t i = 0; i < n; ++i)
+      vin.insert(Record(keys[i], keys[n - i - 1]));
+   *insert_ns = elapsed_ns(start) / n;
+
+   const size_t seeks = 1 << 16;
+   long sum = 0;
+   start = Clock::now();
+   for (size_t i = 0; i < seeks; ++i)
+      sum += vin.lower_bound(Record(0, keys[i % n]), ScoreCmp())->id;
+   *seek_ns = elapsed_ns(start) / seeks;
+   if (sum < 0)
+      cout << sum;
+}
+
+static void bench_static() {
+   cout << "static: ScoreCmp registered at runtime vs as a template argument" 
+      << endl;
+   cout << setw(10) << "n" 
+      << setw(16) << "dyn insert ns" << setw(18) << "static insert ns"
+      << setw(14) << "dyn seek ns" << setw(18) << "static seek ns" << endl;
+
+   for (size_t n = 1 << 10; n <= (1 << 20); n <<= 2) {
+      vector<int> keys = shuffled_keys(n, 42);
+      double dyn_insert, dyn_seek, static_insert, static_seek;
+
+      RecordVindex dyn(make_extractor(Record, id));
+      dyn.push_comparator(ScoreCmp());
+      time_insert_seek(dyn, keys, &dyn_insert, &dyn_seek);
+
+      StaticRecordVindex stat(make_extractor(Record, id));
+      time_insert_seek(stat, keys, &static_insert, &static_seek);
+
+      cout << fixed << setprecision(1)
+         << setw(10) << n
+         << setw(16) << dyn_insert << setw(18) << static_insert
+         << setw(14) << dyn_seek << setw(18) << static_seek << endl;
+   }
+   cout << endl;
+}
+
+template <typename VindexTy>
+static void time_insert_at(
+   VindexTy& vin, const vector<string>& names, double* insert_ns, 
+   double* at_ns) {
+   const size_t n = names.size();
+   Clock::time_point start = Clock::now();
+   for (size_t i = 0; i < n; ++i)
+      vin.insert(Account(names[i], static_cast<int>(i)));
+   *insert_ns = elapsed_ns(start) / n;
+
+   const size_t lookups = 1 << 18;
+   long sum = 0;
+   start = Clock::now();
+   for (size_t i = 0; i < lookups; ++i)
+      sum += vin.at(names[i % n]).balance;
+   *at_ns = elapsed_ns(start) / lookups;
+   if (sum < 0)
+      cout << sum;
+}
+
+static void bench_extractor() {
+   cout << "extractor: string keys via std::function vs a template extractor" 
+      << endl;
+   cout << setw(10) << "n" 
+      << setw(16) << "fn insert ns" << setw(18) << "tmpl insert ns"
+      << setw(14) << "fn at ns" << setw(16) << "tmpl at ns" << endl;
+
+   for (size_t n = 1 << 10; n <= (1 << 20); n <<= 2) {
+      vector<int> keys = shuffled_keys(n, 42);
+      vector<string> names;
+      names.reserve(n);
+      for (size_t i = 0; i < n; ++i)
+         names.push_back("account-holder-" + to_string(keys[i]));
+      double fn_insert, fn_at, tmpl_insert, tmpl_at;
+
+      Vindex<string, Account> fn(make_extractor(Account, name));
+      time_insert_at(fn, names, &fn_insert, &fn_at);
+
+      auto tmpl = make_basic_vindex(Account, name);
+      time_insert_at(tmpl, names, &tmpl_insert, &tmpl_at);
+
+      cout << fixed << setprecision(1)
+         << setw(10) << n
+         << setw(16) << fn_insert << setw(18) << tmpl_insert
+         << setw(14) << fn_at << setw(16) << tmpl_at << endl;
+   }
+   cout << endl;
+}
+
+// Every thread does reads_per_write at() reads per write; a write swaps 
+// a record out and back in, so every key stays readable.
+template <typename ReadFn, typename WriteFn>
+static double mixed_mops(
+   size_t threads, size_t n, size_t reads_per_write, const ReadFn& read, 
+   const WriteFn& write) {
+   const size_t ops = 1 << 17;
+   atomic<long> sink(0);
+   vector<thread> pool;
+   Clock::time_point start = Clock::now();
+   for (size_t t = 0; t < threads; ++t)
+      pool.emplace_back([&, t]() {
+         mt19937 rng(static_cast<unsigned>(t));
+         long sum = 0;
+         for (size_t i = 0; i < ops; ++i) {
+            int key = static_cast<int>(rng() % n);
+            if (i % (reads_per_write + 1) == reads_per_write)
+               write(key);
+            else
+               sum += read(key);
+         }
+         sink += sum;
+      });
+   for (auto it = pool.begin(); it != pool.end(); ++it)
+      it->join();
+   double ns = elapsed_ns(start);
+   if (sink < 0)
+      cout << sink;
+   return threads * ops / ns * 1e3;
+}
+
+static void bench_concurrent() {
+   cout << "concurrent: 50:1 read:write throughput in Mops/s, one mutex vs " 
+      << "ConcurrentVindex" << endl;
+   cout << setw(10) << "threads" << setw(12) << "mutex" 
+      << setw(12) << "rwlock" << endl;
+
+   const size_t n = 1 << 16;
+   vector<int> keys = shuffled_keys(n, 42);
+
+   mutex locked_mutex;
+   RecordVindex locked(make_extractor(Record, id));
+   locked.push_comparator(ScoreCmp());
+
+   ConcurrentVindex<RecordVindex> shared(make_extractor(Record, id));
+   shared.push_comparator(ScoreCmp());
+
+   for (size_t i = 0; i < n; ++i) {
+      locked.insert(Record(keys[i], keys[n - i - 1]));
+      shared.insert(Record(keys[i], keys[n - i - 1]));
+   }
+
+   for (size_t threads = 1; threads <= 8; threads <<= 1) {
+      double locked_mops = mixed_mops(threads, n, 50, 
+         [&](int key) -> long {
+            lock_guard<mutex> lock(locked_mutex);
+            return locked.at(key).score;
+         },
+         [&](int key) {
+            lock_guard<mutex> lock(locked_mutex);
+            Result<Record> res = locked.remove(key);
+            locked.insert(std::move(res.data()));
+         });
+
+      double shared_mops = mixed_mops(threads, n, 50, 
+         [&](int key) -> long {
+            return shared.at(key).score;
+         },
+         [&](int key) {
+            shared.write([key](RecordVindex& vin) {
+               Result<Record> res = vin.remove(key);
+               vin.insert(std::move(res.data()));
+            });
+         });
+
+      cout << fixed << setprecision(1)
+         << setw(10) << threads 
+         << setw(12) << locked_mops << setw(12) << shared_mops << endl;
+   }
+   cout << endl;
+}
+
+// A writer ingests fresh keys while a reader keeps scanning INORDER, 
+// either under the shared lock or over a snapshot taken per scan.
+template <typename ScanFn>
+static void time_ingest_scans(
+   size_t n, const ScanFn& scan, double* insert_ns, size_t* scans) {
+   const size_t writes = 1 << 14;
+   ConcurrentVindex<RecordVindex> cvin(make_extractor(Record, id));
+   cvin.push_comparator(ScoreCmp());
+   vector<int> keys = shuffled_keys(n + writes, 42);
+   for (size_t i = 0; i < n; ++i)
+      cvin.insert(Record(keys[i], keys[i]));
+
+   atomic<bool> done(false);
+   atomic<long> sink(0);
+   thread reader([&]() {
+      size_t count = 0;
+      for (; !done; ++count)
+         sink += scan(cvin);
+      *scans = count;
+   });
+
+   Clock::time_point start = Clock::now();
+   for (size_t i = n; i < n + writes; ++i)
+      cvin.insert(Record(keys[i], keys[i]));
+   *insert_ns = elapsed_ns(start) / writes;
+   done = true;
+   reader.join();
+   if (sink < 0)
+      cout << sink;
+}
+
+static void bench_snapshot() {
+   cout << "snapshot: insert latency next to a scanning reader, locked scan " 
+      << "vs snapshot scan" << endl;
+   cout << setw(10) << "n" 
+      << setw(18) << "locked insert ns" << setw(14) << "locked scans"
+      << setw(16) << "snap insert ns" << setw(14) << "snap scans" << endl;
+
+   typedef ConcurrentVindex<RecordVindex> Records;
+   for (size_t n = 1 << 12; n <= (1 << 18); n <<= 3) {
+      double locked_ns, snap_ns;
+      size_t locked_scans, snap_scans;
+
+      time_ingest_scans(n, [](const Records& cvin) -> long {
+         return cvin.read([](const RecordVindex& vin) -> long {
+            long sum = 0;
+            for (auto it = vin.cbegin(OrderType::INORDER); 
+               it != vin.cend(); ++it)
+               sum += it->score;
+            return sum;
+         });
+      }, &locked_ns, &locked_scans);
+
+      time_ingest_scans(n, [](const Records& cvin) -> long {
+         Records::Snapshot snap = cvin.snapshot();
+         long sum = 0;
+         for (auto it = snap->cbegin(OrderType::INORDER); 
+            it != snap->cend(); ++it)
+            sum += it->score;
+         return sum;
+      }, &snap_ns, &snap_scans);
+
+      cout << fixed << setprecision(1)
+         << setw(10) << n
+         << setw(18) << locked_ns << setw(14) << locked_scans
+         << setw(16) << snap_ns << setw(14) << snap_scans << endl;
+   }
+   cout << endl;
+}
+
+static void bench_sharded() {
+   cout << "sharded: remove/insert throughput in Mops/s and merged INORDER " 
+      << "scan in Mnodes/s, one ConcurrentVindex vs 8 shards" << endl;
+   cout << setw(10) << "threads" << setw(12) << "single" 
+      << setw(12) << "sharded" << endl;
+
+   typedef ShardedVindex<RecordVindex> ShardedRecords;
+   const size_t n = 1 << 16;
+   vector<int> keys = shuffled_keys(n, 42);
+
+   ConcurrentVindex<RecordVindex> single(make_extractor(Record, id));
+   ShardedRecords sharded(make_extractor(Record, id), 8);
+   single.push_comparator(ScoreCmp());
+   sharded.push_comparator(ScoreCmp());
+   for (size_t i = 0; i < n; ++i) {
+      single.insert(Record(keys[i], keys[n - i - 1]));
+      sharded.insert(Record(keys[i], keys[n - i - 1]));
+   }
+
+   for (size_t threads = 1; threads <= 8; threads <<= 1) {
+      double single_mops = mixed_mops(threads, n, 0, 
+         [&](int key) -> long { return single.at(key).score; },
+         [&](int key) {
+            Result<Record> res = single.remove(key);
+            if (res)
+               single.insert(std::move(res.data()));
+         });
+
+      double sharded_mops = mixed_mops(threads, n, 0, 
+         [&](int key) -> long { return sharded.at(key).score; },
+         [&](int key) {
+            Result<Record> res = sharded.remove(key);
+            if (res)
+               sharded.insert(std::move(res.data()));
+         });
+
+      cout << fixed << setprecision(1)
+         << setw(10) << threads 
+         << setw(12) << single_mops << setw(12) << sharded_mops << endl;
+   }
+
+   const size_t rounds = 32;
+   long sum = 0;
+   Clock::time_point start = Clock::now();
+   for (size_t r = 0; r < rounds; ++r)
+      single.for_each(OrderType::INORDER, [&sum](const Record& rec) {
+         sum += rec.score;
+      }, ScoreCmp());
+   double single_scan = rounds * n / elapsed_ns(start) * 1e3;
+
+   start = Clock::now();
+   for (size_t r = 0; r < rounds; ++r)
+      sharded.for_each(OrderType::INORDER, [&sum](const Record& rec) {
+         sum += rec.score;
+      }, ScoreCmp());
+   double sharded_scan = rounds * n / elapsed_ns(start) * 1e3;
+   if (sum < 0)
+      cout << sum;
+
+   cout << fixed << setprecision(1)
+      << setw(10) << "scan" 
+      << setw(12) << single_scan << setw(12) << sharded_scan << endl << endl;
+}
+
+template <typename VindexTy>
+static double time_heads_insert(
+   VindexTy& vin, size_t heads, const vector<int>& keys) {
+   for (size_t h = 1; h < heads; ++h)
+      vin.push_comparator(HashCmp(static_cast<unsigned>(h)));
+
+   Clock::time_point start = Clock::now();
+   for (size_t i = 0; i < keys.size(); ++i)
+      vin.insert(Record(keys[i], keys[i]));
+   return elapsed_ns(start) / keys.size();
+}
+
+static void bench_parallel() {
+   cout << "parallel: insert ns/op by head count, sequential heads vs " 
+      << "ParallelVindex with heads - 1 workers" << endl;
+   cout << setw(10) << "heads" << setw(14) << "sequential" 
+      << setw(14) << "parallel" << endl;
+
+   vector<int> keys = shuffled_keys(1 << 16, 42);
+   for (size_t heads = 1; heads <= 8; heads <<= 1) {
+      ConcurrentVindex<RecordVindex> seq(make_extractor(Record, id));
+      double seq_ns = time_heads_insert(seq, heads, keys);
+
+      ParallelVindex<RecordVindex> par(make_extractor(Record, id), heads - 1);
+      double par_ns = time_heads_insert(par, heads, keys);
+
+      cout << fixed << setprecision(1)
+         << setw(10) << heads 
+         << setw(14) << seq_ns << setw(14) << par_ns << endl;
+   }
+   cout << endl;
+}
+
+static void bench_bulk() {
+   cout << "bulk: cold-start load cost per record, insert() loop vs assign()" 
+      << endl;
+   cout << setw(10) << "n" << setw(14) << "insert ns" 
+      << setw(14) << "assign ns" << endl;
+
+   for (size_t n = 1 << 10; n <= (1 << 20); n <<= 2) {
+      vector<int> keys = shuffled_keys(n, 42);
+      vector<Record> records;
+      records.reserve(n);
+      for (size_t i = 0; i < n; ++i)
+         records.push_back(Record(keys[i], keys[n - i - 1]));
+
+      RecordVindex looped(make_extractor(Record, id));
+      looped.push_comparator(ScoreCmp());
+      Clock::time_point start = Clock::now();
+      for (size_t i = 0; i < n; ++i)
+         looped.insert(records[i]);
+      double insert_ns = elapsed_ns(start) / n;
+
+      RecordVindex bulk(make_extractor(Record, id));
+      bulk.push_comparator(ScoreCmp());
+      start = Clock::now();
+      bulk.assign(records.begin(), records.end());
+      double assign_ns = elapsed_ns(start) / n;
+
+      cout << fixed << setprecision(1)
+         << setw(10) << n 
+         << setw(14) << insert_ns << setw(14) << assign_ns << endl;
+   }
+   cout << endl;
+}
+
+int main(int argc, char** argv) {
+   typedef void (*Bench)();
+   vector<pair<string, Bench>> benches = {
+      { "scaling", bench_scaling },
+      { "churn", bench_churn },
+      { "find", bench_find },
+      { "at", bench_at },
+      { "scan", bench_scan },
+      { "ingest", bench_ingest },
+      { "static", bench_static },
+      { "extractor", bench_extractor },
+      { "concurrent", bench_concurrent },
+      { "snapshot", bench_snapshot },
+      { "sharded", bench_sharded },
+      { "parallel", bench_parallel },
+      { "bulk", bench_bulk }
+   };
+
+   for (auto it = benches.begin(); it != benches.end(); ++it) {
+      bool selected = argc < 2;
+      for (int i = 1; i < argc; ++i)
+         selected = selected || it->first == argv[i];
+      if (selected)
+         it->second();
+   }
+}
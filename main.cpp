@@ -3,6 +3,12 @@
 #include <iostream>
 #include "vindex.h"
 #include <utility>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <thread>
+#include <atomic>
+#include <chrono>
 
 #ifdef NDEBUG
 #undef NDEBUG
@@ -18,6 +24,53 @@ struct Int;
 typedef Vindex<int, BasicInt> IntVindex;
 typedef Vindex<int, Int> IntVindex2;
 
+static std::atomic<size_t> alloc_count(0);
+
+void* operator new(size_t size) {
+   ++alloc_count;
+   void* p = malloc(size);
+   if (!p)
+      throw std::bad_alloc();
+   return p;
+}
+
+void* operator new[](size_t size) {
+   return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) NOEXCEPT {
+   ++alloc_count;
+   return malloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) NOEXCEPT {
+   return operator new(size, tag);
+}
+
+void operator delete(void* p) NOEXCEPT {
+   free(p);
+}
+
+void operator delete(void* p, size_t) NOEXCEPT {
+   operator delete(p);
+}
+
+void operator delete[](void* p) NOEXCEPT {
+   operator delete(p);
+}
+
+void operator delete[](void* p, size_t) NOEXCEPT {
+   operator delete(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) NOEXCEPT {
+   operator delete(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) NOEXCEPT {
+   operator delete(p);
+}
+
 struct BasicInt {
    int val;
 
@@ -114,6 +167,22 @@ struct std::hash<YCmp> {
    }
 };
 
+// Orders by y % mod, so instances with different mods are distinct heads.
+struct ModCmp: public IComparator<Point> {
+   int mod;
+
+   explicit ModCmp(int mod = 7): mod(mod) {}
+
+   bool operator==(const IComparator<Point>& other) const override {
+      auto modcmp = dynamic_cast<const ModCmp*>(&other);
+      return modcmp && mod == modcmp->mod;
+   }
+
+   bool lt(const Point& a, const Point& b) const override {
+      return a.y % mod < b.y % mod || (a.y % mod == b.y % mod && a.x < b.x);
+   }
+};
+
 struct Int {
    int val;
 
@@ -208,6 +277,29 @@ ostream& operator<<(ostream& os, const Terran& t) {
    return os << t.str();
 }
 
+struct CopyCounted {
+   int key;
+   std::string payload;
+   static int copies;
+
+   CopyCounted(int key, const std::string& payload): 
+      key(key), payload(payload) {}
+
+   CopyCounted(const CopyCounted& other): 
+      key(other.key), payload(other.payload) { ++copies; }
+
+   CopyCounted(CopyCounted&& other): 
+      key(other.key), payload(std::move(other.payload)) {}
+
+   bool operator<(const CopyCounted& other) const { return key < other.key; }
+};
+
+int CopyCounted::copies = 0;
+
+ostream& operator<<(ostream& os, const CopyCounted& c) {
+   return os << c.key;
+}
+
 class TestIntVindex {
 private:
    IntVindex _vin;
@@ -295,8 +387,7 @@ public:
    void test_dne_removal() {
       _vin.clear();
       Result<BasicInt> res = _vin.remove(40);
-      auto resf = dynamic_cast<ResultFailure<BasicInt> *>(res.get());
-      assert(resf);
+      assert(!res);
       assert(_vin._bfs_str() == "");
 
       _vin.insert(30);
@@ -305,8 +396,7 @@ public:
       res = _vin.remove(40);
       assert(_vin._bfs_str() == "(data: 30, height: 1, left: null, right: null, parent: null)");
 
-      resf = dynamic_cast<ResultFailure<BasicInt> *>(res.get());
-      assert(resf);
+      assert(!res);
 
       assert(_vin._bfs_str() == "(data: 30, height: 1, left: null, right: null, parent: null)");
    }
@@ -315,9 +405,8 @@ public:
       _vin.clear();
       _vin.insert(30);
       Result<BasicInt> res = _vin.remove(30);
-      auto ress = dynamic_cast<ResultSuccess<BasicInt> *>(res.get());
-      assert(ress);
-      assert(ress->data().val == 30);
+      assert(res);
+      assert(res.data().val == 30);
       assert(_vin._bfs_str() == "");
 
       _vin.insert(30);
@@ -328,9 +417,8 @@ public:
       _vin.remove(30);
 
       res = _vin.remove(20);
-      ress = dynamic_cast<ResultSuccess<BasicInt> *>(res.get());
-      assert(ress);
-      assert(ress->data().val == 20);
+      assert(res);
+      assert(res.data().val == 20);
       assert(_vin._bfs_str() == "(data: 35, height: 2, left: 25, right: 40, parent: null)|(data: 25, height: 1, left: null, right: null, parent: 35) (data: 40, height: 1, left: null, right: null, parent: 35)");
 
       _vin.clear();
@@ -387,15 +475,13 @@ public:
       _vin.insert(40);
       _vin.remove(30);
       Result<BasicInt> res = _vin.remove(35);
-      auto ress = dynamic_cast<ResultSuccess<BasicInt> *>(res.get());
-      assert(ress);
-      assert(ress->data().val == 35);
+      assert(res);
+      assert(res.data().val == 35);
       assert(_vin._bfs_str() == "(data: 25, height: 2, left: 20, right: 40, parent: null)|(data: 20, height: 1, left: null, right: null, parent: 25) (data: 40, height: 1, left: null, right: null, parent: 25)");
 
       res = _vin.remove(20);
-      ress = dynamic_cast<ResultSuccess<BasicInt> *>(res.get());
-      assert(ress);
-      assert(ress->data().val == 20);
+      assert(res);
+      assert(res.data().val == 20);
 
       _vin.remove(25);
       assert(_vin._bfs_str() == "(data: 40, height: 1, left: null, right: null, parent: null)");
@@ -451,9 +537,8 @@ public:
       _vin.insert(20);
       _vin.insert(35);
       Result<BasicInt> res = _vin.remove(25);
-      auto ress = dynamic_cast<ResultSuccess<BasicInt> *>(res.get());
-      assert(ress);
-      assert(ress->data().val == 25);
+      assert(res);
+      assert(res.data().val == 25);
       assert(_vin._bfs_str() == "(data: 35, height: 2, left: 20, right: null, parent: null)|(data: 20, height: 1, left: null, right: null, parent: 35) (null)");
 
       _vin.clear();
@@ -464,9 +549,8 @@ public:
       _vin.insert(30);
       _vin.insert(40);
       res = _vin.remove(35);
-      ress = dynamic_cast<ResultSuccess<BasicInt> *>(res.get());
-      assert(ress);
-      assert(ress->data().val == 35);
+      assert(res);
+      assert(res.data().val == 35);
       assert(_vin._bfs_str() == "(data: 25, height: 3, left: 20, right: 40, parent: null)|(data: 20, height: 2, left: 15, right: null, parent: 25) (data: 40, height: 2, left: 30, right: null, parent: 25)|(data: 15, height: 1, left: null, right: null, parent: 20) (null) (data: 30, height: 1, left: null, right: null, parent: 40) (null)");
 
       _vin.clear();
@@ -537,21 +621,17 @@ public:
 
       Result<Point> rm_res = vin.remove(Point(14, 4));
       assert(vin._bfs_str() == "(data: (10,12), height: 1, left: null, right: null, parent: null)");
-      auto rm = dynamic_cast<ResultSuccess<Point>*>(rm_res.get());
-      assert(rm);
-      assert(rm->data().str() == "(14,4)");
+      assert(rm_res);
+      assert(rm_res.data().str() == "(14,4)");
 
       rm_res = vin.remove(12);
       assert(vin._bfs_str() == "(data: (10,12), height: 1, left: null, right: null, parent: null)");
-      bool rm_failed = false;
-      if (dynamic_cast<ResultFailure<Point>*>(rm_res.get()))
-         rm_failed = true;
-      assert(rm_failed);
+      assert(!rm_res);
 
       rm_res = vin.remove(10);
       assert(vin._bfs_str() == "");
-      if (auto p = dynamic_cast<ResultSuccess<Point>*>(rm_res.get()))
-         assert(p->data().str() == "(10,12)");
+      if (rm_res)
+         assert(rm_res.data().str() == "(10,12)");
       else
          assert(0);
    }
@@ -950,6 +1030,65 @@ public:
       assert(it.curr_level() == 2);
    }
 
+   void test_breadth_first_scan() {
+      _vin.clear();
+      for (int i = 0; i < 1000; ++i)
+         _vin.insert((i * 7919) % 1000);
+
+      int count = 0;
+      int level = 1;
+      for (
+         auto it = _vin.cbegin(OrderType::BREADTHFIRST); 
+         it != _vin.cend(); 
+         ++it, ++count) {
+         assert(it.curr_level() == level || it.curr_level() == level + 1);
+         level = it.curr_level();
+      }
+      assert(count == 1000);
+
+      count = 0;
+      for (
+         auto it = _vin.crbegin(OrderType::BREADTHFIRST); 
+         it != _vin.crend(); 
+         ++it, ++count) {
+         assert(it.curr_level() == level || it.curr_level() == level - 1);
+         level = it.curr_level();
+      }
+      assert(count == 1000 && level == 1);
+
+      // Same shape as test_one_child_orders(): levels 4 and 5 have gaps.
+      _vin.clear();
+      int keys[] = {
+         50, 30, 70, 20, 40, 60, 80, 10, 25, 35, 55, 75, 90, 15, 85};
+      for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i)
+         _vin.insert(keys[i]);
+
+      const vector<int> expected = {
+         50, 30, 70, 20, 40, 60, 80, 10, 25, 35, 55, 75, 90, 15, 85};
+      const vector<int> levels = {1, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 5, 5};
+      vector<int> seq, seq_levels;
+      for (
+         auto it = _vin.cbegin(OrderType::BREADTHFIRST); 
+         it != _vin.cend(); 
+         ++it) {
+         seq.push_back(it->val);
+         seq_levels.push_back(it.curr_level());
+      }
+      assert(seq == expected && seq_levels == levels);
+
+      seq.clear();
+      seq_levels.clear();
+      for (
+         auto it = _vin.crbegin(OrderType::BREADTHFIRST); 
+         it != _vin.crend(); 
+         ++it) {
+         seq.push_back(it->val);
+         seq_levels.push_back(it.curr_level());
+      }
+      assert((seq == vector<int>(expected.rbegin(), expected.rend())));
+      assert((seq_levels == vector<int>(levels.rbegin(), levels.rend())));
+   }
+
    void test_insertion_order_iter() {
       _vin.clear();
       _vin.insert(25);
@@ -1298,6 +1437,46 @@ public:
       assert(it != _vin.crend());
    }
 
+   // Shape with one-child nodes, including both extremes:
+   //
+   //                50
+   //         30            70
+   //      20     40     60      80
+   //    10  25  35    55      75  90
+   //     15                      85
+   void test_one_child_orders() {
+      _vin.clear();
+      int keys[] = {
+         50, 30, 70, 20, 40, 60, 80, 10, 25, 35, 55, 75, 90, 15, 85};
+      for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i)
+         _vin.insert(keys[i]);
+
+      auto forward = [this](OrderType::OrderType order_ty) -> vector<int> {
+         vector<int> seq;
+         for (auto it = _vin.cbegin(order_ty); it != _vin.cend(); ++it)
+            seq.push_back(it->val);
+         return seq;
+      };
+      auto reverse = [this](OrderType::OrderType order_ty) -> vector<int> {
+         vector<int> seq;
+         for (auto it = _vin.crbegin(order_ty); it != _vin.crend(); ++it)
+            seq.push_back(it->val);
+         return seq;
+      };
+
+      assert(_vin.cbegin(OrderType::POSTORDER)->val == 15);
+      assert(_vin.crbegin(OrderType::PREORDER)->val == 85);
+
+      assert((forward(OrderType::PREORDER) == vector<int>{
+         50, 30, 20, 10, 15, 25, 40, 35, 70, 60, 55, 80, 75, 90, 85}));
+      assert((reverse(OrderType::PREORDER) == vector<int>{
+         85, 90, 75, 80, 55, 60, 70, 35, 40, 25, 15, 10, 20, 30, 50}));
+      assert((forward(OrderType::POSTORDER) == vector<int>{
+         15, 10, 25, 20, 35, 40, 30, 55, 60, 75, 85, 90, 80, 70, 50}));
+      assert((reverse(OrderType::POSTORDER) == vector<int>{
+         50, 70, 80, 90, 85, 75, 60, 55, 30, 40, 35, 20, 25, 10, 15}));
+   }
+
    void test_breadth_first_order_rev_iter() {
       _vin.clear();
       _vin.insert(25);
@@ -1512,6 +1691,33 @@ public:
       assert(_vin2._bfs_str() == "(data: i25, height: 4, left: i16, right: i35, parent: null)|(data: i16, height: 2, left: i15, right: i20, parent: i25) (data: i35, height: 3, left: i30, right: i40, parent: i25)|(data: i15, height: 1, left: null, right: null, parent: i16) (data: i20, height: 1, left: null, right: null, parent: i16) (data: i30, height: 2, left: i26, right: i33, parent: i35) (data: i40, height: 1, left: null, right: null, parent: i35)|(null) (null) (null) (null) (data: i26, height: 1, left: null, right: null, parent: i30) (data: i33, height: 1, left: null, right: null, parent: i30) (null) (null)");
    }
 
+   void test_emplace_in_place() {
+      auto vin = make_vindex(CopyCounted, key);
+      CopyCounted::copies = 0;
+
+      assert(vin.emplace(1, "first"));
+      assert(vin.insert(CopyCounted(2, "second")));
+      assert(CopyCounted::copies == 0);
+
+      CopyCounted third(3, "third");
+      assert(vin.insert(third));
+      assert(CopyCounted::copies == 1);
+
+      auto dup = vin.emplace(1, "duplicate");
+      assert(!dup);
+      assert(vin.at(1).payload == "first");
+      assert(vin.size() == 3);
+      assert(vin.pool_stats().live == 3);
+
+      CopyCounted moved(2, "moved");
+      assert(!vin.insert(std::move(moved)));
+      assert(moved.payload == "moved");
+
+      Result<CopyCounted> res = vin.remove(2);
+      assert(res && res.data().payload == "second");
+      assert(CopyCounted::copies == 1);
+   }
+
    void test_find() {
       _vin.clear();
       _vin.insert(25);
@@ -1526,12 +1732,100 @@ public:
       auto it = _vin.find(16, OrderType::INORDER);
       assert(*it == 16);
       assert(*++it == 20);
+      it = _vin.find(16, OrderType::INORDER);
+      assert(*--it == 15);
+
+      it = _vin.find(35, OrderType::PREORDER);
+      assert(*it == 35);
+      assert(*++it == 30);
+      it = _vin.find(35, OrderType::PREORDER);
+      assert(*--it == 20);
+
+      it = _vin.find(15, OrderType::INSERTION);
+      assert(*it == 15);
+      assert(*++it == 30);
+      it = _vin.find(15, OrderType::INSERTION);
+      assert(*--it == 35);
 
       it = _vin.find(100, OrderType::INORDER);
       assert(it == _vin.cend());
       assert(*it == 0);
    }
 
+   void test_bounds() {
+      auto vin = make_vindex(Terran, name);
+      vin.push_comparator(HpCmp());
+      vin.insert(Terran("Matt Horner", "Battlecruiser", 500));
+      vin.insert(Terran("Jim Raynor", "Marine", 100));
+      vin.insert(Terran("Rory Swann", "Marauder", 100));
+      vin.insert(Terran("Gabriel Tosh", "Ghost", 90));
+      vin.insert(Terran("Tychus Findlay", "Marine", 100));
+      vin.insert(Terran("Lily Preston", "Medic", 75));
+
+      vector<string> names;
+      auto hp = [](int hp) -> Terran { return Terran("", "", hp); };
+
+      auto range = vin.equal_range(hp(100), HpCmp());
+      for (auto it = range.first; it != range.second; ++it)
+         names.push_back(it->name);
+      assert(names.size() == 3);
+      assert(std::is_permutation(names.begin(), names.end(), 
+         vector<string>{"Jim Raynor", "Rory Swann", "Tychus Findlay"}.begin()));
+
+      names.clear();
+      auto last = vin.upper_bound(hp(100), HpCmp());
+      for (auto it = vin.lower_bound(hp(80), HpCmp()); it != last; ++it)
+         names.push_back(it->name);
+      assert(names.size() == 4 && names.front() == "Gabriel Tosh");
+
+      assert(vin.lower_bound(hp(75), HpCmp())->name == "Lily Preston");
+      assert(vin.upper_bound(hp(100), HpCmp())->name == "Matt Horner");
+      assert(vin.lower_bound(hp(501), HpCmp()) == vin.cend());
+
+      auto it = vin.lower_bound(Terran("K", "", 0));
+      assert(it->name == "Lily Preston");
+      assert((--it)->name == "Jim Raynor");
+      range = vin.equal_range(Terran("Kerrigan", "", 0));
+      assert(range.first == range.second);
+   }
+
+   void test_order_statistics() {
+      auto vin = make_vindex(Terran, name);
+      vin.push_comparator(HpCmp());
+      vin.insert(Terran("Matt Horner", "Battlecruiser", 500));
+      vin.insert(Terran("Jim Raynor", "Marine", 100));
+      vin.insert(Terran("Rory Swann", "Marauder", 110));
+      vin.insert(Terran("Gabriel Tosh", "Ghost", 90));
+      vin.insert(Terran("Tychus Findlay", "Marine", 100));
+      vin.insert(Terran("Lily Preston", "Medic", 75));
+
+      auto hp = [](int hp) -> Terran { return Terran("", "", hp); };
+
+      assert(vin.select(0, HpCmp())->name == "Lily Preston");
+      assert(vin.select(4, HpCmp())->name == "Rory Swann");
+      assert(vin.select(5, HpCmp())->name == "Matt Horner");
+      assert(vin.select(6, HpCmp()) == vin.cend());
+      assert(vin.select(2)->name == "Lily Preston");
+
+      auto it = vin.select(1, HpCmp());
+      assert(it->name == "Gabriel Tosh");
+      assert((++it)->hp == 100);
+
+      assert(vin.rank(hp(75), HpCmp()) == 0);
+      assert(vin.rank(hp(100), HpCmp()) == 2);
+      assert(vin.rank(hp(101), HpCmp()) == 4);
+      assert(vin.rank(hp(1000), HpCmp()) == 6);
+      assert(vin.rank(Terran("Matt Horner", "", 0)) == 3);
+
+      assert(vin.count_range(hp(90), hp(110), HpCmp()) == 3);
+      assert(vin.count_range(hp(0), hp(1000), HpCmp()) == 6);
+      assert(vin.count_range(hp(110), hp(90), HpCmp()) == 0);
+
+      vin.remove("Jim Raynor");
+      assert(vin.count_range(hp(90), hp(110), HpCmp()) == 2);
+      assert(vin.select(2, HpCmp())->name == "Tychus Findlay");
+   }
+
    void test_index_insert_removal() {
       _vin2.clear();
       _vin2.insert(25);
@@ -1581,9 +1875,8 @@ public:
 
       auto assert_successful_results = 
          [&cnt](ConstResult<BasicInt&>& r, int exp) {
-            if (auto res = 
-               dynamic_cast<ConstResultSuccess<BasicInt&> *>(r.get())) {
-               assert(res->data() == exp);
+            if (r) {
+               assert(r.data() == exp);
                ++cnt;
             }
             else {
@@ -1594,8 +1887,7 @@ public:
 
       auto assert_failing_results = 
          [&cnt](ConstResult<BasicInt&>& r) {
-            if (auto res = 
-               dynamic_cast<ConstResultFailure<BasicInt&> *>(r.get())) {
+            if (!r) {
                ++cnt;
             }
             else {
@@ -1659,6 +1951,39 @@ public:
       assert(myvin3._bfs_str() == "(data: i35, height: 4, left: i20, right: i40, parent: null)|(data: i20, height: 3, left: i18, right: i25, parent: i35) (data: i40, height: 2, left: null, right: i42, parent: i35)|(data: i18, height: 2, left: i16, right: null, parent: i20) (data: i25, height: 2, left: i22, right: i30, parent: i20) (null) (data: i42, height: 1, left: null, right: null, parent: i40)|(data: i16, height: 1, left: null, right: null, parent: i18) (null) (data: i22, height: 1, left: null, right: null, parent: i25) (data: i30, height: 1, left: null, right: null, parent: i25) (null) (null) (null) (null)");
    }
 
+   void test_make_basic_vindex() {
+      auto vin = make_basic_vindex(Terran, name);
+      vin.push_comparator(HpCmp());
+
+      vin.insert(Terran("Jim Raynor", "Marine", 100));
+      vin.insert(Terran("Gabriel Tosh", "Ghost", 90));
+      vin.insert(Terran("Lily Preston", "Medic", 75));
+      assert(!vin.insert(Terran("Jim Raynor", "Ghost", 1)));
+      assert(vin.at("Gabriel Tosh").hp == 90);
+      assert(vin.find("Lily Preston", OrderType::INORDER)->hp == 75);
+      assert(vin.cbegin(OrderType::INORDER, HpCmp())->name == "Lily Preston");
+
+      vin.remove("Gabriel Tosh");
+      assert(vin.size() == 2);
+      assert(vin.cbegin(OrderType::INORDER)->name == "Jim Raynor");
+
+      auto vin2 = basic_vindex<Terran, HpCmp>(
+         [](const Terran& t) -> int { return t.hp; });
+      vin2.insert(Terran("Jim Raynor", "Marine", 100));
+      vin2.insert(Terran("Lily Preston", "Medic", 75));
+      assert(vin2.at(75).name == "Lily Preston");
+      assert(vin2._heads.size() == 2);
+
+      auto moved = vin;
+      moved.insert(Terran("Matt Horner", "Battlecruiser", 500));
+      vin = std::move(moved);
+      assert(vin.size() == 3 && moved.size() == 0);
+      assert(vin.at("Matt Horner").hp == 500);
+      assert(vin.cbegin(OrderType::INORDER, HpCmp())->name == "Lily Preston");
+      vin.insert(Terran("Rory Swann", "Engineer", 120));
+      assert(vin.find("Rory Swann", OrderType::INORDER)->hp == 120);
+   }
+
    void test_size() {
       _vin.clear();
       _vin.insert(25);
@@ -1676,6 +2001,110 @@ public:
       assert(_vin.size() == 0);
    }
 
+   void test_pool_stats() {
+      _vin.clear();
+      NodePoolStats stats = _vin.pool_stats();
+      assert(stats.slabs == 0 && stats.live == 0 && stats.free == 0);
+
+      _vin.insert(25);
+      _vin.insert(20);
+      _vin.insert(35);
+      stats = _vin.pool_stats();
+      assert(stats.slabs == 1 && stats.live == 3 && stats.free == 0);
+
+      _vin.remove(20);
+      stats = _vin.pool_stats();
+      assert(stats.slabs == 1 && stats.live == 2 && stats.free == 1);
+
+      _vin.insert(15);
+      stats = _vin.pool_stats();
+      assert(stats.slabs == 1 && stats.live == 3 && stats.free == 0);
+      assert(_vin._bfs_str() == "(data: 25, height: 2, left: 15, right: 35, parent: null)|(data: 15, height: 1, left: null, right: null, parent: 25) (data: 35, height: 1, left: null, right: null, parent: 25)");
+
+      _vin.clear();
+      stats = _vin.pool_stats();
+      assert(stats.slabs == 0 && stats.live == 0 && stats.free == 0);
+   }
+
+   void test_insert_allocations() {
+      Vindex<int, Point> vin(make_extractor(Point, x));
+      vin.push_comparator(YCmp());
+      for (int i = 0; i < 100; ++i)
+         vin.emplace(i, 100 - i);
+      vin.remove(50);
+
+      size_t before = alloc_count;
+      vin.emplace(50, 7);
+      vin.remove(50);
+      vin.emplace(50, 7);
+      assert(alloc_count == before);
+
+      Vindex<int, Point> reserved(make_extractor(Point, x));
+      reserved.reserve(1000);
+      size_t capacity = reserved._index.capacity();
+      for (int i = 0; i < 1000; ++i)
+         reserved.emplace(i, -i);
+      assert(reserved._index.capacity() == capacity);
+      assert(reserved._index.size() == 1000);
+
+      before = alloc_count;
+      for (auto it = vin.cbegin(OrderType::INORDER, YCmp()); 
+         it != vin.cend(); ++it);
+      assert(alloc_count == before);
+   }
+
+   void test_assign() {
+      vector<Terran> terrans = {
+         Terran("Jim Raynor", "Marine", 100),
+         Terran("Gabriel Tosh", "Ghost", 90),
+         Terran("Rory Swann", "Marauder", 100),
+         Terran("Jim Raynor", "Ghost", 1),
+         Terran("Lily Preston", "Medic", 75),
+         Terran("Tychus Findlay", "Marine", 100)
+      };
+
+      auto vin = make_vindex(Terran, name);
+      vin.push_comparator(HpCmp());
+      vin.insert(Terran("Matt Horner", "Battlecruiser", 500));
+      vin.assign(terrans.begin(), terrans.end());
+      assert(vin.size() == 5);
+      assert(vin.at("Jim Raynor").hp == 100);
+
+      vector<string> names;
+      for (
+         auto it = vin.cbegin(OrderType::INORDER, HpCmp()); 
+         it != vin.cend(); 
+         ++it)
+         names.push_back(it->name);
+      assert((names == vector<string>{
+         "Lily Preston", "Gabriel Tosh", "Jim Raynor", "Rory Swann", 
+         "Tychus Findlay"}));
+
+      names.clear();
+      for (
+         auto it = vin.cbegin(OrderType::INSERTION); 
+         it != vin.cend(); 
+         ++it)
+         names.push_back(it->name);
+      assert((names == vector<string>{
+         "Jim Raynor", "Gabriel Tosh", "Rory Swann", "Lily Preston", 
+         "Tychus Findlay"}));
+
+      assert(vin.rank(Terran("", "", 100), HpCmp()) == 2);
+      assert(vin.select(4, HpCmp())->name == "Tychus Findlay");
+      vin.emplace("Matt Horner", "Battlecruiser", 500);
+      vin.remove("Gabriel Tosh");
+      assert(vin.select(4, HpCmp())->name == "Matt Horner");
+
+      vector<Point> points;
+      for (int i = 0; i < 1000; ++i)
+         points.emplace_back((i * 7919) % 1000, i);
+      Vindex<int, Point, YCmp> pvin(make_extractor(Point, x));
+      pvin.assign(points.begin(), points.end());
+      for (size_t slot = 0; slot < pvin._heads.size(); ++slot)
+         assert(pvin._heads.at(slot)->root->height(slot) == 10);
+   }
+
    void test_iter_on_empty_vin() {
       _vin.clear();
       auto it = _vin.cbegin(OrderType::INORDER);
@@ -1684,6 +2113,37 @@ public:
       assert(it == _vin.cend());
    }
 
+   void test_iter_trivially_copyable() {
+      typedef IntVindex::const_iterator It;
+      typedef IntVindex::const_reverse_iterator RevIt;
+      static_assert(std::is_trivially_copyable<It>::value, "");
+      static_assert(std::is_trivially_copyable<RevIt>::value, "");
+      static_assert(sizeof(It) <= 2 * sizeof(void*), "");
+
+      _vin.clear();
+      for (int i = 1; i <= 3; ++i)
+         _vin.insert(i);
+
+      auto it = _vin.cbegin(OrderType::INORDER);
+      auto copy = it;
+      ++it;
+      assert(*copy == 1 && *it == 2);
+
+      ++it;
+      ++it;
+      assert(it == _vin.cend());
+      ++it;
+      assert(it == _vin.cend());
+      assert(*--it == 3);
+
+      --it;
+      --it;
+      --it;
+      assert(it == _vin.cend());
+      --it;
+      assert(*++it == 1);
+   }
+
    void test_multi_comparators() {
       Vindex<int, Point> vin(make_extractor(Point, x));
       vin.emplace(3, 3);
@@ -1702,6 +2162,16 @@ public:
       assert(vin._bfs_str() == "(data: (3,3), height: 3, left: (2,4), right: (4,2), parent: null)|(data: (2,4), height: 2, left: (1,5), right: null, parent: (3,3)) (data: (4,2), height: 1, left: null, right: null, parent: (3,3))|(data: (1,5), height: 1, left: null, right: null, parent: (2,4)) (null) (null) (null)");
 
       assert(vin._bfs_str("|", ycmp) == "(data: (3,3), height: 3, left: (4,2), right: (2,4), parent: null)|(data: (4,2), height: 1, left: null, right: null, parent: (3,3)) (data: (2,4), height: 2, left: null, right: (1,5), parent: (3,3))|(null) (null) (null) (data: (1,5), height: 1, left: null, right: null, parent: (2,4))");
+
+      assert(vin._heads.size() == 2);
+      vin.push_comparator(YCmp(12, 14));
+      assert(vin._heads.size() == 2);
+      vin.push_comparator(YCmp(1, 2));
+      assert(vin._heads.size() == 3);
+      assert(vin._heads.find(YCmp(1, 2))->slot == 2);
+      assert(vin._heads.find(ycmp)->slot == 1);
+      assert(vin._heads.find(YCmp(3, 4)) == nullptr);
+      assert(vin.select(0, YCmp(1, 2))->x == 4);
    }
 
    void test_multi_comparators_iter() {
@@ -1721,6 +2191,7 @@ public:
       vin.emplace(1, 5);
 
       auto ycmp = YCmp(30);
+      vin.push_comparator(ycmp);
 
       vector<string> v;
       for (auto it = vin.cbegin(OrderType::INORDER); it != vin.cend(); ++it) {
@@ -1755,7 +2226,6 @@ public:
       assert(ss.str() == "[(1,5), (4,2), (2,4), (3,3)]");
       reset(v, ss);
 
-      vin.push_comparator(ycmp);
       for (auto it = vin.crbegin(OrderType::PREORDER, ycmp); 
          it != vin.crend(); ++it) {
          stringstream ss;
@@ -1773,6 +2243,8 @@ public:
       //    [](const Terran& t) -> std::string { return t.name; });
       // Vindex<std::string, Terran> vin(make_extractor(Terran, name));
       auto vin = make_vindex(Terran, name);
+      vin.push_comparator(OccupationCmp());
+      vin.push_comparator(HpCmp());
       vin.emplace("Jim Raynor", "Marine", 100);
       vin.insert(Terran("Matt Horner", "Battlecruiser", 500));
       vin.emplace("Tychus Findlay", "Marine", 100);
@@ -1818,9 +2290,8 @@ public:
       assert(vin._bfs_str("|", OccupationCmp()) == "(data: (Jim Raynor,Marine,100), height: 3, left: (Gabriel Tosh,Ghost,90), right: (Tychus Findlay,Marine,100), parent: null)|(data: (Gabriel Tosh,Ghost,90), height: 2, left: (Matt Horner,Battlecruiser,500), right: (Rory Swann,Marauder,100), parent: (Jim Raynor,Marine,100)) (data: (Tychus Findlay,Marine,100), height: 2, left: null, right: (Lily Preston,Medic,75), parent: (Jim Raynor,Marine,100))|(data: (Matt Horner,Battlecruiser,500), height: 1, left: null, right: null, parent: (Gabriel Tosh,Ghost,90)) (data: (Rory Swann,Marauder,100), height: 1, left: null, right: null, parent: (Gabriel Tosh,Ghost,90)) (null) (data: (Lily Preston,Medic,75), height: 1, left: null, right: null, parent: (Tychus Findlay,Marine,100))");
 
       Result<Terran> res = vin.remove("Tychus Findlay");
-      auto success = dynamic_cast<ResultSuccess<Terran>*>(res.get());
-      assert(success);
-      assert(success->data().name == "Tychus Findlay");
+      assert(res);
+      assert(res.data().name == "Tychus Findlay");
 
       assert(vin._bfs_str("|") == "(data: (Matt Horner,Battlecruiser,500), height: 3, left: (Jim Raynor,Marine,100), right: (Rory Swann,Marauder,100), parent: null)|(data: (Jim Raynor,Marine,100), height: 2, left: (Gabriel Tosh,Ghost,90), right: (Lily Preston,Medic,75), parent: (Matt Horner,Battlecruiser,500)) (data: (Rory Swann,Marauder,100), height: 1, left: null, right: null, parent: (Matt Horner,Battlecruiser,500))|(data: (Gabriel Tosh,Ghost,90), height: 1, left: null, right: null, parent: (Jim Raynor,Marine,100)) (data: (Lily Preston,Medic,75), height: 1, left: null, right: null, parent: (Jim Raynor,Marine,100)) (null) (null)");
       assert(vin._bfs_str("|", HpCmp()) == "(data: (Rory Swann,Marauder,100), height: 3, left: (Gabriel Tosh,Ghost,90), right: (Matt Horner,Battlecruiser,500), parent: null)|(data: (Gabriel Tosh,Ghost,90), height: 2, left: (Lily Preston,Medic,75), right: (Jim Raynor,Marine,100), parent: (Rory Swann,Marauder,100)) (data: (Matt Horner,Battlecruiser,500), height: 1, left: null, right: null, parent: (Rory Swann,Marauder,100))|(data: (Lily Preston,Medic,75), height: 1, left: null, right: null, parent: (Gabriel Tosh,Ghost,90)) (data: (Jim Raynor,Marine,100), height: 1, left: null, right: null, parent: (Gabriel Tosh,Ghost,90)) (null) (null)");
@@ -1833,8 +2304,7 @@ public:
       assert(vin._bfs_str("|", OccupationCmp()) == "(data: (Gabriel Tosh,Ghost,90), height: 3, left: (Matt Horner,Battlecruiser,500), right: (Jim Raynor,Marine,100), parent: null)|(data: (Matt Horner,Battlecruiser,500), height: 1, left: null, right: null, parent: (Gabriel Tosh,Ghost,90)) (data: (Jim Raynor,Marine,100), height: 2, left: (Rory Swann,Marauder,100), right: null, parent: (Gabriel Tosh,Ghost,90))|(null) (null) (data: (Rory Swann,Marauder,100), height: 1, left: null, right: null, parent: (Jim Raynor,Marine,100)) (null)");
 
       res = vin.remove("Lily Preston");
-      auto failure = dynamic_cast<ResultFailure<Terran>*>(res.get());
-      assert(failure);
+      assert(!res);
 
       std::vector<std::string> actual;
       std::vector<std::string> exp(
@@ -1883,23 +2353,11 @@ public:
 
       assert(actual == exp);
 
-      assert(
-         dynamic_cast<ResultSuccess<Terran>*>(
-            vin.remove("Gabriel Tosh").get()
-         )
-      );
+      assert(vin.remove("Gabriel Tosh"));
 
-      assert(
-         dynamic_cast<ResultSuccess<Terran>*>(
-            vin.remove("Rory Swann").get()
-         )
-      );
+      assert(vin.remove("Rory Swann"));
 
-      assert(
-         dynamic_cast<ResultSuccess<Terran>*>(
-            vin.remove("Matt Horner").get()
-         )
-      );
+      assert(vin.remove("Matt Horner"));
 
       actual.clear();
       exp = std::vector<std::string>({
@@ -1942,6 +2400,465 @@ public:
 
       assert(actual == exp);
    }
+
+   void test_const_reads() {
+      auto vin = make_vindex(Terran, name);
+      vin.insert(Terran("Jim Raynor", "Marine", 100));
+      vin.insert(Terran("Gabriel Tosh", "Ghost", 90));
+      vin.insert(Terran("Lily Preston", "Medic", 75));
+
+      const auto& cvin = vin;
+      auto hp = [](int hp) -> Terran { return Terran("", "", hp); };
+
+      bool thrown = false;
+      try {
+         cvin.cbegin(OrderType::INORDER, HpCmp());
+      }
+      catch (const std::invalid_argument&) {
+         thrown = true;
+      }
+      assert(thrown);
+      assert(vin._heads.size() == 1);
+
+      thrown = false;
+      try {
+         cvin.lower_bound(hp(80), HpCmp());
+      }
+      catch (const std::invalid_argument&) {
+         thrown = true;
+      }
+      assert(thrown);
+
+      vin.push_comparator(HpCmp());
+      vector<string> names;
+      for (
+         auto it = cvin.cbegin(OrderType::INORDER, HpCmp()); 
+         it != cvin.cend(); 
+         ++it)
+         names.push_back(it->name);
+      assert((names == vector<string>{
+         "Lily Preston", "Gabriel Tosh", "Jim Raynor"}));
+      assert(cvin.lower_bound(hp(80), HpCmp())->name == "Gabriel Tosh");
+      assert(cvin.rank(hp(100), HpCmp()) == 2);
+      assert(cvin.find("Jim Raynor", OrderType::INORDER)->hp == 100);
+      assert(cvin.size() == 3);
+   }
+
+   void test_copy() {
+      Vindex<int, Point, YCmp> vin(make_extractor(Point, x));
+      for (int i = 0; i < 200; ++i)
+         vin.emplace(i, (i * 7) % 200);
+      for (int i = 0; i < 200; i += 3)
+         vin.remove(i);
+
+      Vindex<int, Point, YCmp> copy(vin);
+      assert(copy.size() == vin.size());
+      assert(copy.pool_stats().live == vin.pool_stats().live);
+      assert(copy.pool_stats().free == vin.pool_stats().free);
+      for (int o = OrderType::INORDER; o <= OrderType::INSERTION; ++o) {
+         auto order_ty = static_cast<OrderType::OrderType>(o);
+         auto it = vin.cbegin(order_ty, YCmp());
+         auto copy_it = copy.cbegin(order_ty, YCmp());
+         for (; it != vin.cend(); ++it, ++copy_it) {
+            assert(copy_it != copy.cend());
+            assert(&*copy_it != &*it && copy_it->x == it->x);
+         }
+         assert(copy_it == copy.cend());
+      }
+
+      for (int i = 0; i < 200; i += 3)
+         copy.emplace(i, -i);
+      assert(copy.size() == 200 && vin.size() == 133);
+      assert(copy.pool_stats().free == 0);
+      assert(copy.at(3).y == -3 && copy.at(4).y == 28);
+      assert(copy.cbegin(OrderType::INORDER, YCmp())->x == 198);
+      assert(vin.cbegin(OrderType::INORDER, YCmp())->x == 143);
+   }
+
+   void test_concurrent_vindex() {
+      typedef ConcurrentVindex<Vindex<int, Point>> ConcurrentPoints;
+      ConcurrentPoints cvin(make_extractor(Point, x));
+      cvin.push_comparator(YCmp());
+
+      std::thread writer([&cvin]() {
+         for (int i = 0; i < 1000; ++i)
+            cvin.emplace(i, -i);
+      });
+
+      auto sorted_by_y = [](const ConcurrentPoints::Vindex& vin) -> bool {
+         size_t count = 0;
+         int prev_y = -1000;
+         for (
+            auto it = vin.cbegin(OrderType::INORDER, YCmp()); 
+            it != vin.cend(); 
+            ++it, ++count) {
+            if (it->y <= prev_y)
+               return false;
+            prev_y = it->y;
+         }
+         return count == vin.size();
+      };
+
+      vector<std::thread> readers;
+      for (int r = 0; r < 3; ++r)
+         readers.emplace_back([&cvin, sorted_by_y]() {
+            for (int i = 0; i < 100; ++i) {
+               assert(cvin.read(sorted_by_y));
+               assert(sorted_by_y(*cvin.snapshot()));
+            }
+         });
+
+      writer.join();
+      for (auto it = readers.begin(); it != readers.end(); ++it)
+         it->join();
+
+      assert(cvin.size() == 1000);
+      assert(!cvin.emplace(5, 5));
+      assert(cvin.at(5).y == -5);
+
+      int count = 0;
+      cvin.for_each(OrderType::INORDER, [&count](const Point& p) {
+         assert(p.y == -count);
+         ++count;
+      });
+      assert(count == 1000);
+
+      auto res = cvin.remove(5);
+      assert(res && res.data().y == -5);
+      assert(!cvin.remove(5));
+
+      bool thrown = false;
+      try {
+         cvin.at(5);
+      }
+      catch (const std::out_of_range&) {
+         thrown = true;
+      }
+      assert(thrown && cvin.size() == 999);
+   }
+
+   void test_writer_progress() {
+      typedef ConcurrentVindex<Vindex<int, Point>> ConcurrentPoints;
+      ConcurrentPoints cvin(make_extractor(Point, x));
+      cvin.push_comparator(YCmp());
+      for (int i = 0; i < 1000; ++i)
+         cvin.emplace(i, -i);
+
+      std::atomic<bool> stop(false);
+      vector<std::thread> readers;
+      for (int r = 0; r < 3; ++r)
+         readers.emplace_back([&cvin, &stop]() {
+            while (!stop) {
+               long sum = 0;
+               cvin.for_each(OrderType::INORDER, [&sum](const Point& p) {
+                  sum += p.y;
+               });
+            }
+         });
+
+      std::atomic<bool> done(false);
+      std::thread writer([&cvin, &done]() {
+         for (int i = 0; i < 200; ++i) {
+            assert(cvin.remove(i % 1000));
+            assert(cvin.emplace(i % 1000, -(i % 1000)));
+         }
+         done = true;
+      });
+
+      for (int i = 0; i < 1000 && !done; ++i)
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      assert(done);
+
+      stop = true;
+      writer.join();
+      for (auto it = readers.begin(); it != readers.end(); ++it)
+         it->join();
+      assert(cvin.size() == 1000);
+   }
+
+   void test_snapshots() {
+      typedef ConcurrentVindex<Vindex<std::string, Terran>> Terrans;
+      Terrans cvin(make_extractor(Terran, name));
+      cvin.push_comparator(HpCmp());
+      cvin.insert(Terran("Jim Raynor", "Marine", 100));
+      cvin.insert(Terran("Gabriel Tosh", "Ghost", 90));
+
+      Terrans::Snapshot first = cvin.snapshot();
+      assert(first->size() == 2);
+      cvin.insert(Terran("Lily Preston", "Medic", 75));
+      assert(first->size() == 2);
+
+      Terrans::Snapshot snap = cvin.snapshot();
+      assert(snap != first && cvin.snapshot() == snap);
+      first.reset();
+
+      cvin.insert(Terran("Matt Horner", "Battlecruiser", 500));
+      cvin.remove("Jim Raynor");
+      assert(cvin.snapshot() != snap);
+      assert(snap->size() == 3 && cvin.size() == 3);
+      assert(snap->at("Jim Raynor").hp == 100);
+
+      vector<string> names;
+      for (
+         auto it = snap->cbegin(OrderType::INORDER, HpCmp()); 
+         it != snap->cend(); 
+         ++it)
+         names.push_back(it->name);
+      assert((names == vector<string>{
+         "Lily Preston", "Gabriel Tosh", "Jim Raynor"}));
+
+      names.clear();
+      for (
+         auto it = snap->cbegin(OrderType::INSERTION); 
+         it != snap->cend(); 
+         ++it)
+         names.push_back(it->name);
+      assert((names == vector<string>{
+         "Jim Raynor", "Gabriel Tosh", "Lily Preston"}));
+
+      names.clear();
+      cvin.for_each(OrderType::INORDER, [&names](const Terran& t) {
+         names.push_back(t.name);
+      }, HpCmp());
+      assert((names == vector<string>{
+         "Lily Preston", "Gabriel Tosh", "Matt Horner"}));
+
+      std::weak_ptr<const Terrans::Vindex> dropped = cvin.snapshot();
+      assert(dropped.expired());
+      Terrans::Snapshot again = cvin.snapshot();
+      assert(again->size() == 3 && again->at("Matt Horner").hp == 500);
+      assert(cvin.snapshot() == again);
+      cvin.clear();
+      again.reset();
+      assert(cvin.snapshot()->size() == 0);
+   }
+
+   void test_sharded_vindex() {
+      ShardedVindex<Vindex<int, Point>> svin(make_extractor(Point, x), 4);
+      svin.push_comparator(YCmp());
+      assert(svin.num_shards() == 4);
+
+      vector<std::thread> writers;
+      for (int w = 0; w < 2; ++w)
+         writers.emplace_back([&svin, w]() {
+            for (int i = w; i < 1000; i += 2)
+               svin.emplace(i, (i * 7) % 1000);
+         });
+      for (auto it = writers.begin(); it != writers.end(); ++it)
+         it->join();
+
+      assert(svin.size() == 1000);
+      assert(!svin.emplace(3, 0));
+      assert(svin.at(3).y == 21);
+
+      int expected_x = 0;
+      svin.for_each(OrderType::INORDER, [&expected_x](const Point& p) {
+         assert(p.x == expected_x);
+         ++expected_x;
+      });
+      assert(expected_x == 1000);
+
+      int expected_y = 0;
+      svin.for_each(OrderType::INORDER, [&expected_y](const Point& p) {
+         assert(p.y == expected_y);
+         ++expected_y;
+      }, YCmp());
+      assert(expected_y == 1000);
+
+      YCmp ycmp;
+      const IComparator<Point>& abstract_cmp = ycmp;
+      expected_y = 0;
+      svin.for_each(OrderType::INORDER, [&expected_y](const Point& p) {
+         assert(p.y == expected_y);
+         ++expected_y;
+      }, abstract_cmp);
+      assert(expected_y == 1000);
+
+      int sum_x = 0;
+      svin.for_each(OrderType::INSERTION, [&sum_x](const Point& p) {
+         sum_x += p.x;
+      });
+      assert(sum_x == 999 * 1000 / 2);
+
+      assert(svin.remove(3) && !svin.remove(3));
+      assert(svin.size() == 999);
+      svin.clear();
+      assert(svin.size() == 0);
+   }
+
+   void test_parallel_vindex() {
+      typedef ParallelVindex<Vindex<int, Point, YCmp>> ParallelPoints;
+      ParallelPoints pvin(make_extractor(Point, x), 2);
+
+      vector<std::thread> threads;
+      for (int w = 0; w < 2; ++w)
+         threads.emplace_back([&pvin, w]() {
+            for (int i = w; i < 1000; i += 2)
+               pvin.emplace(i, (i * 7) % 1000);
+         });
+      for (int r = 0; r < 2; ++r)
+         threads.emplace_back([&pvin]() {
+            for (int i = 0; i < 20; ++i) {
+               int prev_y = -1;
+               pvin.for_each(OrderType::INORDER, [&prev_y](const Point& p) {
+                  assert(p.y > prev_y);
+                  prev_y = p.y;
+               }, YCmp());
+            }
+         });
+      for (auto it = threads.begin(); it != threads.end(); ++it)
+         it->join();
+
+      assert(pvin.size() == 1000);
+      assert(!pvin.emplace(3, 0));
+      assert(pvin.at(3).y == 21);
+
+      ParallelVindex<Vindex<std::string, Terran>> terrans(
+         make_extractor(Terran, name));
+      terrans.push_comparator(HpCmp());
+      terrans.push_comparator(OccupationCmp());
+      terrans.insert(Terran("Jim Raynor", "Marine", 100));
+      terrans.insert(Terran("Gabriel Tosh", "Ghost", 90));
+      terrans.insert(Terran("Lily Preston", "Medic", 75));
+      assert(terrans.remove("Gabriel Tosh").data().hp == 90);
+      assert(!terrans.remove("Gabriel Tosh"));
+
+      vector<string> names;
+      auto push_name = [&names](const Terran& t) { names.push_back(t.name); };
+      terrans.for_each(OrderType::INORDER, push_name, HpCmp());
+      terrans.for_each(OrderType::INORDER, push_name, OccupationCmp());
+      terrans.for_each(OrderType::INSERTION, push_name);
+      assert((names == vector<string>{
+         "Lily Preston", "Jim Raynor", 
+         "Jim Raynor", "Lily Preston", 
+         "Jim Raynor", "Lily Preston"}));
+
+      // Five heads with explicit workers, so mutations go through the pool.
+      ParallelPoints wide(make_extractor(Point, x), 2);
+      wide.push_comparator(ModCmp(3));
+      wide.push_comparator(ModCmp(5));
+      wide.push_comparator(ModCmp(7));
+
+      const ModCmp mods[] = {ModCmp(3), ModCmp(5), ModCmp(7)};
+      threads.clear();
+      for (int w = 0; w < 2; ++w)
+         threads.emplace_back([&wide, w]() {
+            for (int i = w; i < 600; i += 2)
+               assert(wide.emplace(i, (i * 7) % 600));
+            for (int i = w; i < 600; i += 4)
+               assert(wide.remove(i));
+         });
+      for (int r = 0; r < 3; ++r)
+         threads.emplace_back([&wide, &mods, r]() {
+            for (int i = 0; i < 20; ++i) {
+               const Point* prev = nullptr;
+               wide.for_each(OrderType::INORDER, 
+                  [&mods, r, &prev](const Point& p) {
+                     assert(!prev || mods[r].lt(*prev, p));
+                     prev = &p;
+                  }, mods[r]);
+            }
+         });
+      for (auto it = threads.begin(); it != threads.end(); ++it)
+         it->join();
+
+      assert(wide.size() == 300);
+      for (int r = 0; r < 3; ++r) {
+         vector<Point> seq;
+         wide.for_each(OrderType::INORDER, [&seq](const Point& p) {
+            seq.push_back(p);
+         }, mods[r]);
+         assert(seq.size() == 300);
+         for (size_t i = 0; i < seq.size(); ++i)
+            assert(seq[i].x % 4 >= 2 && seq[i].y == (seq[i].x * 7) % 600);
+         for (size_t i = 1; i < seq.size(); ++i)
+            assert(mods[r].lt(seq[i - 1], seq[i]));
+      }
+      int prev_y = -1;
+      wide.for_each(OrderType::INORDER, [&prev_y](const Point& p) {
+         assert(p.y > prev_y);
+         prev_y = p.y;
+      }, YCmp());
+
+      _WorkerPool pool(2);
+      vector<std::atomic<int>> runs(8);
+      for (int round = 0; round < 3; ++round)
+         pool.run(runs.size(), [&runs](size_t i) { ++runs[i]; });
+      for (size_t i = 0; i < runs.size(); ++i)
+         assert(runs[i] == 3);
+   }
+
+   void test_static_comparators() {
+      auto vin = make_static_vindex(Terran, name, HpCmp, OccupationCmp);
+      assert(vin._heads.size() == 3);
+      assert(vin._find_head(HpCmp())->slot == 1);
+      assert(vin._find_head(OccupationCmp())->slot == 2);
+
+      vin.insert(Terran("Matt Horner", "Battlecruiser", 500));
+      vin.insert(Terran("Jim Raynor", "Marine", 100));
+      vin.insert(Terran("Gabriel Tosh", "Ghost", 90));
+      vin.insert(Terran("Lily Preston", "Medic", 75));
+      vin.push_comparator(HpCmp());
+      assert(vin._heads.size() == 3);
+
+      vector<string> names;
+      for (
+         auto it = vin.cbegin(OrderType::INORDER, HpCmp()); 
+         it != vin.cend(); 
+         ++it)
+         names.push_back(it->name);
+      assert((names == vector<string>{
+         "Lily Preston", "Gabriel Tosh", "Jim Raynor", "Matt Horner"}));
+
+      names.clear();
+      for (
+         auto it = vin.crbegin(OrderType::INORDER, OccupationCmp()); 
+         it != vin.crend(); 
+         ++it)
+         names.push_back(it->occupation);
+      assert((names == vector<string>{
+         "Medic", "Marine", "Ghost", "Battlecruiser"}));
+
+      auto hp = [](int hp) -> Terran { return Terran("", "", hp); };
+      assert(vin.lower_bound(hp(80), HpCmp())->name == "Gabriel Tosh");
+      assert(vin.rank(hp(100), HpCmp()) == 2);
+
+      vin.remove("Gabriel Tosh");
+      assert(vin.lower_bound(hp(80), HpCmp())->name == "Jim Raynor");
+      assert(vin.select(1, OccupationCmp())->name == "Jim Raynor");
+
+      Vindex<string, Terran, HpCmp> vin2(
+         make_extractor(Terran, name), std::make_tuple(HpCmp()));
+      vin2.insert(Terran("Jim Raynor", "Marine", 100));
+      assert(vin2.cbegin(OrderType::INORDER, HpCmp())->hp == 100);
+
+      Vindex<int, Point, ModCmp> mods(
+         make_extractor(Point, x), std::make_tuple(ModCmp(7)));
+      for (int i = 0; i < 5; ++i)
+         mods.emplace(i, i);
+      mods.push_comparator(ModCmp(5));
+      mods.push_comparator(ModCmp(7));
+      assert(mods._heads.size() == 3);
+      assert(mods._find_head(ModCmp(7))->slot == 1);
+      assert(mods._find_head(ModCmp(5))->slot == 2);
+      assert(!mods._find_head(ModCmp(3)));
+      for (int i = 5; i < 10; ++i)
+         mods.emplace(i, i);
+
+      auto xs = [&mods](const ModCmp& cmp) -> vector<int> {
+         vector<int> seq;
+         for (
+            auto it = mods.cbegin(OrderType::INORDER, cmp); 
+            it != mods.cend(); 
+            ++it)
+            seq.push_back(it->x);
+         return seq;
+      };
+      assert((xs(ModCmp(7)) == vector<int>{0, 7, 1, 8, 2, 9, 3, 4, 5, 6}));
+      assert((xs(ModCmp(5)) == vector<int>{0, 5, 1, 6, 2, 7, 3, 8, 4, 9}));
+      assert(mods.lower_bound(Point(0, 8), ModCmp(7))->x == 1);
+      assert(mods.lower_bound(Point(0, 8), ModCmp(5))->x == 3);
+   }
 };
 
 int main () {
@@ -1958,28 +2875,46 @@ int main () {
    vin.test_iterative_remove();
 
    vin.test_iter_on_empty_vin();
+   vin.test_iter_trivially_copyable();
 
    vin.test_in_order_iter();
    vin.test_in_order_iter_arrow_data();
    vin.test_pre_order_iter();
    vin.test_post_order_iter();
    vin.test_breadth_first_order_iter();
+   vin.test_breadth_first_scan();
    vin.test_insertion_order_iter();
 
    vin.test_in_order_rev_iter();
    vin.test_pre_order_rev_iter();
    vin.test_post_order_rev_iter();
+   vin.test_one_child_orders();
    vin.test_breadth_first_order_rev_iter();
    vin.test_insertion_order_rev_iter();
 
    vin.test_emplace();
+   vin.test_emplace_in_place();
    vin.test_find();
+   vin.test_bounds();
+   vin.test_order_statistics();
    vin.test_index_insert_removal();
    vin.test_insert_return();
    vin.test_make_vindex();
+   vin.test_make_basic_vindex();
    vin.test_size();
+   vin.test_pool_stats();
+   vin.test_insert_allocations();
+   vin.test_assign();
 
    vin.test_multi_comparators();
    vin.test_multi_comparators_iter();
+   vin.test_const_reads();
+   vin.test_static_comparators();
+   vin.test_copy();
+   vin.test_concurrent_vindex();
+   vin.test_writer_progress();
+   vin.test_snapshots();
+   vin.test_sharded_vindex();
+   vin.test_parallel_vindex();
    vin.doc_example();
 }
@@ -14,10 +14,17 @@
 #include <list>
 #include <functional>
 #include <mutex>
-#include <unordered_map>
 #include <vector>
 #include <typeinfo>
 #include <tuple>
+#include <new>
+#include <cstddef>
+#include <type_traits>
+#include <stdexcept>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <condition_variable>
 
 #pragma push_macro("assert")
 #ifdef assert
@@ -51,6 +58,73 @@ namespace std {
 }
 #endif
 
+// Reader-writer lock used instead of std::shared_timed_mutex on every 
+// standard: glibc's rwlock prefers readers and lets a steady read load 
+// starve writers. Here waiting writers block new readers.
+class _SharedMutex {
+private:
+   std::mutex _mutex;
+   std::condition_variable _cv;
+   size_t _readers;
+   size_t _waiting_writers;
+   bool _writer;
+
+public:
+   _SharedMutex(): _readers(0), _waiting_writers(0), _writer(false) {}
+
+   _SharedMutex(const _SharedMutex&) = delete;
+   _SharedMutex& operator=(const _SharedMutex&) = delete;
+
+   void lock() {
+      std::unique_lock<std::mutex> lock(_mutex);
+      ++_waiting_writers;
+      _cv.wait(lock, [this]() { return !_writer && !_readers; });
+      --_waiting_writers;
+      _writer = true;
+   }
+
+   void unlock() {
+      {
+         std::lock_guard<std::mutex> lock(_mutex);
+         _writer = false;
+      }
+      _cv.notify_all();
+   }
+
+   void lock_shared() {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait(lock, [this]() { return !_writer && !_waiting_writers; });
+      ++_readers;
+   }
+
+   void unlock_shared() {
+      bool last = false;
+      {
+         std::lock_guard<std::mutex> lock(_mutex);
+         last = --_readers == 0;
+      }
+      if (last)
+         _cv.notify_all();
+   }
+};
+
+class _SharedLock {
+private:
+   _SharedMutex& _mutex;
+
+public:
+   explicit _SharedLock(_SharedMutex& mutex): _mutex(mutex) {
+      _mutex.lock_shared();
+   }
+
+   ~_SharedLock() {
+      _mutex.unlock_shared();
+   }
+
+   _SharedLock(const _SharedLock&) = delete;
+   _SharedLock& operator=(const _SharedLock&) = delete;
+};
+
 #if defined(_MSC_VER) && _MSC_VER >= 1900 || \
    !defined(_MSC_VER) && __cplusplus >= 201103L
 #define NOEXCEPT noexcept
@@ -59,12 +133,24 @@ namespace std {
 #endif
 
 #define make_extractor(CLS, MEM)\
-   [](const CLS& obj) -> decltype(CLS::MEM) { return obj.MEM; }
+   [](const CLS& obj) -> const decltype(CLS::MEM)& { return obj.MEM; }
 
 #define make_vindex(CLS, MEM)\
    Vindex<decltype(CLS::MEM), CLS>(make_extractor(CLS, MEM))
 
-template <typename T, typename KeyTy> class Vindex;
+#define make_static_vindex(CLS, MEM, ...)\
+   Vindex<decltype(CLS::MEM), CLS, __VA_ARGS__>(make_extractor(CLS, MEM))
+
+#define make_basic_vindex(CLS, MEM)\
+   basic_vindex<CLS>(make_extractor(CLS, MEM))
+
+template <
+   typename KeyTy, typename T, typename ExtractorTy, typename... Cmps>
+class BasicVindex;
+
+template <typename KeyTy, typename T, typename... Cmps>
+using Vindex = 
+   BasicVindex<KeyTy, T, std::function<KeyTy(const T&)>, Cmps...>;
 
 namespace hash_helpers {
    inline size_t combine(const std::vector<size_t>& hashes) NOEXCEPT {
@@ -75,117 +161,180 @@ namespace hash_helpers {
    }
 }
 
+template <typename U, typename... Ts>
+struct _type_index;
+
+template <typename U>
+struct _type_index<U>: std::integral_constant<size_t, 0> {};
+
+template <typename U, typename... Ts>
+struct _type_index<U, U, Ts...>: std::integral_constant<size_t, 0> {};
+
+template <typename U, typename V, typename... Ts>
+struct _type_index<U, V, Ts...>: 
+   std::integral_constant<size_t, 1 + _type_index<U, Ts...>::value> {};
+
+template <typename... Ts>
+struct _all_distinct: std::true_type {};
+
+template <typename U, typename... Ts>
+struct _all_distinct<U, Ts...>: std::integral_constant<bool, 
+   _type_index<U, Ts...>::value == sizeof...(Ts) && 
+   _all_distinct<Ts...>::value> {};
+
 namespace OrderType {
    enum OrderType { INORDER, PREORDER, POSTORDER, BREADTHFIRST, INSERTION };
 }
 
-namespace _head_type {
-   struct node_ref {};
-   struct node_data {};
-}
-
 namespace _Direction {
    enum Direction { LEFT, RIGHT, ROOT };
 }
 
-namespace _IterTracker {
-   template <typename IterTy>
-   class IterTrackerBase {
-   private:
-      IterTy _curr;
-      IterTy _begin;
-      IterTy _end;
-
-   protected:
-      IterTrackerBase() {}
-      IterTrackerBase(IterTy curr, IterTy begin, IterTy end): 
-         _curr(curr), _begin(begin), _end(end) {}
-      IterTrackerBase(IterTy begin, IterTy end): 
-         IterTrackerBase(begin, begin, end) {}
-
-   public:
-      virtual IterTy& curr() { return _curr; }
-      virtual IterTy& begin() { return _begin; }
-      virtual IterTy& end() { return _end; }
-   };
-
-   template <typename NodeDataTy, typename KeyTy, typename IterTy> 
-   class IterTracker: public IterTrackerBase<IterTy> {
-   public:
-      IterTracker(): IterTrackerBase<IterTy>() {}
+template <typename T>
+class ConstResult;
 
-      IterTracker(
-         const typename 
-         Vindex<KeyTy, NodeDataTy>::template NodeList<NodeDataTy&>& l):
-         IterTrackerBase<IterTy>(l.begin(), l.end()) {}
-   };
+template <typename T>
+class ConstResult<T&> {
+private:
+   const T* _data;
 
-   template <typename T, typename KeyTy>
-   using NodeListRevIter = 
-      typename Vindex<KeyTy, T>::template NodeList<T&>::const_reverse_iterator;
+public:
+   ConstResult() NOEXCEPT: _data(nullptr) {}
 
-   template <typename NodeDataTy, typename KeyTy>
-   class IterTracker<
-         NodeDataTy, 
-         KeyTy,
-         NodeListRevIter<NodeDataTy, KeyTy>
-      >: public IterTrackerBase<NodeListRevIter<NodeDataTy, KeyTy>> {
-   public:
-      IterTracker(): IterTrackerBase<NodeListRevIter<NodeDataTy, KeyTy>>() {}
+   explicit ConstResult(const T& data) NOEXCEPT: _data(&data) {}
 
-      IterTracker(
-         const typename 
-         Vindex<KeyTy, NodeDataTy>::template NodeList<NodeDataTy&>& l):
-         IterTrackerBase<NodeListRevIter<NodeDataTy, KeyTy>>(
-            l.rbegin(), l.rend()) {}
-   };
-}
+   explicit operator bool() const NOEXCEPT { 
+      return _data != nullptr; 
+   }
 
-template <typename T>
-class _IConstResult {
-public:
-   virtual ~_IConstResult() {}
+   const T& data() const { 
+      assert(_data, "ResultFailureError");
+      return *_data; 
+   }
 };
 
 template <typename T>
-class ConstResultSuccess: public _IConstResult<T> {
+class Result {
 private:
-   T _data;
-   ConstResultSuccess& operator=(const ConstResultSuccess&) = delete;
+   typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage;
+   bool _success;
 
-public:
-   ConstResultSuccess(const T& data): _data(data) {}
-   const T& data() { return _data; }
-};
+   Result(const Result&) = delete;
+   Result& operator=(const Result&) = delete;
 
-template <typename T>
-class ConstResultFailure: public _IConstResult<T> {};
+   T* _ptr() { 
+      return reinterpret_cast<T*>(&_storage); 
+   }
 
-template <typename T>
-using ConstResult = std::unique_ptr<_IConstResult<T>>;
+   const T* _ptr() const { 
+      return reinterpret_cast<const T*>(&_storage); 
+   }
+
+   void _reset() {
+      if (_success)
+         _ptr()->~T();
+      _success = false;
+   }
 
-template <typename T>
-class _IResult {
 public:
-   virtual ~_IResult() {}
+   Result() NOEXCEPT: _success(false) {}
+
+   explicit Result(T&& data): _success(true) {
+      new (&_storage) T(std::move(data));
+   }
+
+   Result(Result&& other): _success(other._success) {
+      if (_success)
+         new (&_storage) T(std::move(*other._ptr()));
+      other._reset();
+   }
+
+   Result& operator=(Result&& other) {
+      if (this == &other)
+         return *this;
+      _reset();
+      if (other._success) {
+         new (&_storage) T(std::move(*other._ptr()));
+         _success = true;
+      }
+      other._reset();
+      return *this;
+   }
+
+   ~Result() {
+      _reset();
+   }
+
+   explicit operator bool() const NOEXCEPT { 
+      return _success; 
+   }
+
+   T& data() {
+      assert(_success, "ResultFailureError");
+      return *_ptr();
+   }
+
+   const T& data() const {
+      assert(_success, "ResultFailureError");
+      return *_ptr();
+   }
 };
 
-template <typename T>
-class ResultSuccess: public _IResult<T> {
+// Holds a callable that need not be assignable, such as a lambda. 
+// Assignment destroys the held callable and constructs the new one in 
+// its place.
+template <typename Fn>
+class _Reassignable {
 private:
-   T _data;
+   typename std::aligned_storage<sizeof(Fn), alignof(Fn)>::type _storage;
+
+   Fn* _ptr() { 
+      return reinterpret_cast<Fn*>(&_storage); 
+   }
+
+   const Fn* _ptr() const { 
+      return reinterpret_cast<const Fn*>(&_storage); 
+   }
 
 public:
-   template <typename U>
-   ResultSuccess(U&& data): _data(std::forward<U>(data)) {}
-   T& data() { return _data; }
-};
+   explicit _Reassignable(const Fn& fn) {
+      new (&_storage) Fn(fn);
+   }
 
-template <typename T>
-class ResultFailure: public _IResult<T> {};
+   _Reassignable(const _Reassignable& other) {
+      new (&_storage) Fn(*other._ptr());
+   }
 
-template <typename T>
-using Result = std::unique_ptr<_IResult<T>>;
+   _Reassignable(_Reassignable&& other) {
+      new (&_storage) Fn(std::move(*other._ptr()));
+   }
+
+   _Reassignable& operator=(const _Reassignable& other) {
+      if (this != &other) {
+         _ptr()->~Fn();
+         new (&_storage) Fn(*other._ptr());
+      }
+      return *this;
+   }
+
+   _Reassignable& operator=(_Reassignable&& other) {
+      if (this != &other) {
+         _ptr()->~Fn();
+         new (&_storage) Fn(std::move(*other._ptr()));
+      }
+      return *this;
+   }
+
+   ~_Reassignable() {
+      _ptr()->~Fn();
+   }
+
+   template <typename Arg>
+   auto operator()(const Arg& arg) const -> 
+      decltype(std::declval<const Fn&>()(arg)) {
+      return (*_ptr())(arg);
+   }
+};
 
 template <typename T, typename DerivedTy>
 class _Singleton {
@@ -220,20 +369,9 @@ struct IComparator {
       return lt(b, a); 
    }
 
-   virtual size_t hash() const { 
-      return typeid(*this).hash_code(); 
-   }
-
    virtual ~IComparator() {}
 };
 
-template <typename T>
-struct std::hash<IComparator<T>> {
-   virtual size_t operator()(const IComparator<T>& other) const {
-      return other.hash();
-   }
-};
-
 template <typename T>
 struct DefaultComparator: public IComparator<T> {
    bool operator==(const IComparator<T>& other) const override { 
@@ -250,839 +388,871 @@ struct _Node {
    typedef T DataTy;
    T data;
    _Node() {}
-   _Node(const T& data): data(data) {}
+
+   template <typename... Args>
+   explicit _Node(Args&&... args): data(std::forward<Args>(args)...) {}
 
 private:
    _Node& operator=(const _Node&) = delete;
 };
 
-template <typename T, typename BASE_TY=typename T::DataTy>
-struct _AVLState: public T {
-   typedef std::unique_ptr<_AVLState> AVLStateOwner;
-
+template <typename NodeTy>
+struct _AVLState {
    size_t height;
-   AVLStateOwner left;
-   AVLStateOwner right;
-   _AVLState* parent;
-
-   _AVLState* left_raw() const {
-      return left.get();
-   }
-
-   _AVLState* right_raw() const {
-      return right.get();
-   }
+   size_t size;
+   NodeTy* left;
+   NodeTy* right;
+   NodeTy* parent;
 
    _AVLState(): 
-      T(BASE_TY()), height(0),
-      left(nullptr), right(nullptr), parent(nullptr) {}
-
-   _AVLState(const BASE_TY& data): 
-      T(data), height(0), 
-      left(nullptr), right(nullptr), parent(nullptr) {}
+      height(0), size(0), left(nullptr), right(nullptr), parent(nullptr) {}
 };
 
 template <typename T>
-class _Heads {
-public:
-   typedef IComparator<T> Comparator;
-   typedef _AVLState<_Node<T&>> NodeRef;
-   typedef std::unique_ptr<NodeRef> NodeRefOwner;
-
-private:
-   typedef std::unique_ptr<Comparator> ComparatorOwner; 
-   typedef _AVLState<_Node<T>> NodeData;
-   typedef std::unique_ptr<NodeData> NodeDataOwner;
-
-   std::pair<ComparatorOwner, NodeDataOwner> _primary_head;
+struct _MultiTreeNode: public _Node<T> {
+   typedef _AVLState<_MultiTreeNode> State;
 
-   std::unordered_map<
-      ComparatorOwner, 
-      NodeRefOwner,
-      std::function<size_t(const ComparatorOwner&)>,
-      std::function<bool(const ComparatorOwner&, const ComparatorOwner&)>
-   > _secondary_heads;
+   _MultiTreeNode* prev_inserted;
+   _MultiTreeNode* next_inserted;
 
-public:
-   class iterator: public std::iterator<
-      std::forward_iterator_tag, 
-      std::pair<Comparator&, NodeRefOwner&>
-   > {
-   private:
-      typedef decltype(_Heads<T>::_secondary_heads) HeadTy;
-      typedef std::pair<Comparator&, NodeRefOwner&> Entry;
-      typedef std::vector<Entry> EntryArray;
-      typedef typename EntryArray::iterator EntryArrayIter;
-
-      std::shared_ptr<EntryArray> _heads;
-      EntryArrayIter _iter;
-
-   public:
-      iterator() {}
-
-      iterator(HeadTy* heads): 
-         _heads(std::make_shared<EntryArray>()) {
-         for (auto it = heads->begin(); it != heads->end(); ++it) {
-            _heads->emplace_back(std::make_pair<
-               std::reference_wrapper<Comparator>, 
-               std::reference_wrapper<NodeRefOwner>
-            >(*it->first, it->second));
-         }
-         _iter = _heads->begin();
-      }
-
-      bool operator==(const iterator& other) {
-         return _iter == other._iter;
-      }
-
-      bool operator!=(const iterator& other) {
-         return _iter != other._iter;
-      }
+   template <typename... Args>
+   _MultiTreeNode(size_t num_slots, Args&&... args): 
+      _Node<T>(std::forward<Args>(args)...), 
+      prev_inserted(nullptr), next_inserted(nullptr) {
+      for (size_t slot = 0; slot < num_slots; ++slot)
+         new (&state(slot)) State();
+   }
 
-      iterator& operator++() {
-         ++_iter;
-         return *this;   
-      }
+   static size_t alloc_size(size_t num_slots) {
+      const size_t align = alignof(_MultiTreeNode) > alignof(State) ?
+         alignof(_MultiTreeNode) : alignof(State);
+      return _round_up(_states_offset() + num_slots * sizeof(State), align);
+   }
 
-      iterator operator++(int) {
-         auto tmp = *this;
-         operator++();
-         return tmp;
-      }
+   State& state(size_t slot) { 
+      return _states()[slot]; 
+   }
 
-      Entry& operator*() {
-         return *_iter;
-      }
+   const State& state(size_t slot) const { 
+      return const_cast<_MultiTreeNode*>(this)->_states()[slot]; 
+   }
 
-      EntryArrayIter operator->() {
-         return _iter;
-      }
+   size_t& height(size_t slot) { return state(slot).height; }
+   size_t& size(size_t slot) { return state(slot).size; }
+   _MultiTreeNode*& left(size_t slot) { return state(slot).left; }
+   _MultiTreeNode*& right(size_t slot) { return state(slot).right; }
+   _MultiTreeNode*& parent(size_t slot) { return state(slot).parent; }
 
-      iterator end() {
-         iterator it = *this;
-         it._iter = it._heads->end();
-         return it;
-      }
-   };
+   size_t height(size_t slot) const { return state(slot).height; }
+   size_t size(size_t slot) const { return state(slot).size; }
+   _MultiTreeNode* left(size_t slot) const { return state(slot).left; }
+   _MultiTreeNode* right(size_t slot) const { return state(slot).right; }
+   _MultiTreeNode* parent(size_t slot) const { return state(slot).parent; }
 
 private:
-   iterator _end_iter;
-
-   static size_t hash_comparator(const ComparatorOwner& c) {
-      return std::hash<Comparator>()(*c);
+   static size_t _round_up(size_t n, size_t align) {
+      return (n + align - 1) / align * align;
    }
 
-   static bool is_equal_comparator(
-      const ComparatorOwner& c1, const ComparatorOwner& c2) {
-      return *c1 == *c2;
+   static size_t _states_offset() {
+      return _round_up(sizeof(_MultiTreeNode), alignof(State));
    }
 
-   template <typename CmpTy>
-   std::unique_ptr<std::pair<Comparator&, NodeRefOwner&>> 
-      _get(const CmpTy& cmp, _head_type::node_ref) {
-
-      auto it = _secondary_heads.find(std::make_unique<CmpTy>(cmp));
-      if (it != _secondary_heads.end())
-         return std::make_unique<std::pair<Comparator&, NodeRefOwner&>>(
-            *it->first, it->second);
-      return std::unique_ptr<std::pair<Comparator&, NodeRefOwner&>>();
+   State* _states() {
+      return reinterpret_cast<State*>(
+         reinterpret_cast<char*>(this) + _states_offset());
    }
+};
 
-   template <typename CmpTy>
-   std::unique_ptr<std::pair<Comparator&, const NodeRefOwner&>> 
-      _get(const CmpTy& cmp, _head_type::node_ref) const {
-
-      auto it = _secondary_heads.find(std::make_unique<CmpTy>(cmp));
-      if (it != _secondary_heads.end())
-         return std::make_unique<std::pair<Comparator&, const NodeRefOwner&>>(
-            *it->first, it->second);
-      return std::unique_ptr<std::pair<Comparator&, const NodeRefOwner&>>();
-   }
+template <typename NodeTy>
+struct _InsertionList {
+   NodeTy* first;
+   NodeTy* last;
 
-   template <typename CmpTy>
-   std::unique_ptr<std::pair<Comparator&, NodeDataOwner&>> 
-      _get(const CmpTy& cmp, _head_type::node_data) {
+   _InsertionList(): first(nullptr), last(nullptr) {}
 
-      if (_primary_head.first && cmp == *_primary_head.first)
-         return std::make_unique<std::pair<Comparator&, NodeDataOwner&>>(
-            *_primary_head.first, _primary_head.second);
-      return std::unique_ptr<std::pair<Comparator&, NodeDataOwner&>>();
+   _InsertionList(_InsertionList&& other): 
+      first(other.first), last(other.last) {
+      other.clear();
    }
 
-   template <typename CmpTy>
-   std::unique_ptr<std::pair<Comparator&, const NodeDataOwner&>> 
-      _get(const CmpTy& cmp, _head_type::node_data) const {
-
-      if (_primary_head.first && cmp == *_primary_head.first)
-         return std::make_unique<std::pair<Comparator&, const NodeDataOwner&>>(
-            *_primary_head.first, _primary_head.second);
-      return std::unique_ptr<std::pair<Comparator&, const NodeDataOwner&>>();
+   _InsertionList& operator=(_InsertionList&& other) {
+      first = other.first;
+      last = other.last;
+      other.clear();
+      return *this;
    }
 
-public:
-   _Heads(): _secondary_heads(0, hash_comparator, is_equal_comparator) {}
-
-   _Heads(_Heads&& other) {
-      _primary_head = std::move(other._primary_head);
-      _secondary_heads = std::move(other._secondary_heads);
-   };
-
-   template <typename CmpTy>
-   void push(const CmpTy& cmp) { 
-      ComparatorOwner new_cmp = std::make_unique<CmpTy>(cmp);
-      if (!_primary_head.first)
-         _primary_head.first = std::move(new_cmp);
-      else if (_secondary_heads.find(new_cmp) == _secondary_heads.end())
-         _secondary_heads[std::move(new_cmp)];
-   }
-
-   template <typename HeadTy, typename CmpTy>
-   std::unique_ptr<
-      std::pair<
-         Comparator&, 
-         typename std::conditional<
-            std::is_same<HeadTy, _head_type::node_ref>::value, 
-            const NodeRefOwner&, 
-            const NodeDataOwner&
-         >::type
-      >
-   > get(const CmpTy& cmp) const {
-      return _get(cmp, HeadTy());
-   }
-
-   template <typename HeadTy, typename CmpTy>
-   std::unique_ptr<
-      std::pair<
-         Comparator&, 
-         typename std::conditional<
-            std::is_same<HeadTy, _head_type::node_ref>::value, 
-            NodeRefOwner&, 
-            NodeDataOwner&
-         >::type
-      >
-   > get(const CmpTy& cmp) {
-      return _get(cmp, HeadTy());
-   }
-
-   iterator begin() {
-      iterator it(&_secondary_heads);
-      _end_iter = it.end();
-      return it;
+   void push_back(NodeTy* n) {
+      n->prev_inserted = last;
+      n->next_inserted = nullptr;
+      (last ? last->next_inserted : first) = n;
+      last = n;
    }
 
-   iterator end() {
-      return _end_iter;
+   void erase(NodeTy* n) {
+      (n->prev_inserted ? n->prev_inserted->next_inserted : first) = 
+         n->next_inserted;
+      (n->next_inserted ? n->next_inserted->prev_inserted : last) = 
+         n->prev_inserted;
+      n->prev_inserted = n->next_inserted = nullptr;
    }
 
-   template <typename CmpTy>
-   bool exists(const CmpTy& cmp) const {
-      return static_cast<bool>(get<_head_type::node_ref>(cmp));
+   void clear() {
+      first = last = nullptr;
    }
 };
 
-template <typename KeyTy, typename T>
-class Vindex {
-   static_assert(
-      !std::is_lvalue_reference<T>::value && !std::is_pointer<T>::value, 
-      "T cannot be an lvalue reference");
-private:
-   friend class TestIntVindex;
-
-   typedef _Direction::Direction Direction;
-   typedef OrderType::OrderType OrderType;
-   typedef std::function<void()> VoidFunc;
-   typedef std::function<KeyTy(const T&)> Extractor;
-   typedef std::map<OrderType, std::string> OrderTypeToStr;
-   typedef typename _Heads<T>::Comparator Comparator;
-   typedef typename _Heads<T>::NodeRefOwner NodeRefOwner;
+struct NodePoolStats {
+   size_t slabs;
+   size_t live;
+   size_t free;
 
-   template <typename U>
-   using AVLNode = _AVLState<_Node<U>>;
+   NodePoolStats(): slabs(0), live(0), free(0) {}
+};
 
-   template <typename U>
-   using AVLNodeOwner = std::unique_ptr<AVLNode<U>>;
+template <typename NodeTy>
+class _NodePool {
+   static_assert(alignof(NodeTy) <= alignof(std::max_align_t),
+      "NodeTy cannot be over-aligned");
+private:
+   struct _FreeSlot {
+      _FreeSlot* next;
+   };
 
-   template <typename U>
-   using NodeCache = std::map<AVLNode<U>*, AVLNodeOwner<U>>;
+   static const size_t MIN_SLAB_SLOTS = 64;
+   static const size_t MAX_SLAB_SLOTS = 1 << 16;
 
-   template <typename U>
-   using NodeCacheIter = typename NodeCache<U>::iterator;
+   std::vector<std::unique_ptr<char[]>> _slabs;
+   size_t _slot_size;
+   size_t _slab_slots;
+   size_t _bump;
+   _FreeSlot* _free_list;
+   NodePoolStats _stats;
 
-   template <typename U>
-   using NodeDQ = std::deque<AVLNode<U>*>;
+   _NodePool(const _NodePool&) = delete;
+   _NodePool& operator=(const _NodePool&) = delete;
 
-   template <typename U>
-   using NodeListener = std::function<void(AVLNode<U>*)>;
+   void _reset() {
+      _slab_slots = 0;
+      _bump = 0;
+      _free_list = nullptr;
+      _stats = NodePoolStats();
+   }
 
-   template <typename U>
-   using TreeEditAction = std::function<AVLNodeOwner<U>(AVLNodeOwner<U>*)>;
+   static size_t _next_slab_slots(size_t slab_slots) {
+      return !slab_slots ? MIN_SLAB_SLOTS :
+         slab_slots * 2 > MAX_SLAB_SLOTS ? MAX_SLAB_SLOTS : slab_slots * 2;
+   }
 
-   template <typename U>
-   using NodeTracker = std::tuple<
-      AVLNode<U>*, 
-      const Comparator&, 
-      AVLNodeOwner<U>*
-   >;
+   void* _take_slot() {
+      void* slot = nullptr;
 
-   template <typename U>
-   using Index = std::unordered_map<
-      KeyTy, 
-      std::list<NodeTracker<U>>
-   >;
+      if (_free_list) {
+         slot = _free_list;
+         _free_list = _free_list->next;
+         --_stats.free;
+      }
+      else {
+         if (_bump == _slab_slots) {
+            _slab_slots = _next_slab_slots(_slab_slots);
+            _slabs.emplace_back(new char[_slab_slots * _slot_size]);
+            _bump = 0;
+            ++_stats.slabs;
+         }
+         slot = _slabs.back().get() + _bump++ * _slot_size;
+      }
+      return slot;
+   }
 
 public:
-   class const_iterator;
-   class const_reverse_iterator;
+   // Maps each slot of one pool to the slot at the same slab and offset 
+   // of a pool that mirrors it. A lookup is a binary search over slabs.
+   class Relocation {
+   private:
+      typedef std::pair<const char*, char*> SlabPair;
 
-   template <typename U>
-   using NodeList = std::list<AVLNode<U>*>;
+      std::vector<SlabPair> _slabs;
+
+      char* _relocate(const void* p) const {
+         const char* addr = static_cast<const char*>(p);
+         auto it = std::upper_bound(_slabs.begin(), _slabs.end(), addr, 
+            [](const char* a, const SlabPair& slab) { 
+               return std::less<const char*>()(a, slab.first); 
+            });
+         --it;
+         return it->second + (addr - it->first);
+      }
 
-private:
-   class OrderTypeToStrSingleton : 
-      public _Singleton<OrderTypeToStr, OrderTypeToStrSingleton> {
    public:
-      static void init(OrderTypeToStr* order_ty_to_str) {
-         (*order_ty_to_str)[OrderType::INORDER] = "INORDER";
-         (*order_ty_to_str)[OrderType::PREORDER] = "PREORDER";
-         (*order_ty_to_str)[OrderType::POSTORDER] = "POSTORDER";
-         (*order_ty_to_str)[OrderType::BREADTHFIRST] = "BREADTHFIRST";
-         (*order_ty_to_str)[OrderType::INSERTION] = "INSERTION";
+      Relocation(const _NodePool& from, const _NodePool& to) {
+         assert(from._slabs.size() == to._slabs.size(), "MismatchError");
+         _slabs.reserve(from._slabs.size());
+         for (size_t i = 0; i < from._slabs.size(); ++i)
+            _slabs.emplace_back(from._slabs[i].get(), to._slabs[i].get());
+         std::sort(_slabs.begin(), _slabs.end(), 
+            [](const SlabPair& a, const SlabPair& b) { 
+               return std::less<const char*>()(a.first, b.first); 
+            });
       }
-   }; 
 
-   struct AVLNodeDefaultSingleton :
-      public _Singleton<AVLNode<T>, AVLNodeDefaultSingleton> {
-      static void init(AVLNode<T>*) {}
-   };
+      NodeTy* operator()(const NodeTy* n) const {
+         return n ? reinterpret_cast<NodeTy*>(_relocate(n)) : nullptr;
+      }
 
-   struct DefaultComparatorSingleton:
-      public _Singleton<DefaultComparator<T>, DefaultComparatorSingleton> {
-      static void init(DefaultComparator<T>*) {}
+      void* operator()(const _FreeSlot* slot) const {
+         return _relocate(slot);
+      }
    };
 
-   template <bool reverse>
-   class _const_iterator : 
-      public std::iterator<std::bidirectional_iterator_tag, T> {
-   private:
-      typedef typename Vindex<KeyTy, T>::Direction Direction;
-      typedef typename _Heads<T>::Comparator Comparator;
+   _NodePool(size_t slot_size): 
+      _slot_size(slot_size > sizeof(_FreeSlot) ? 
+         slot_size : sizeof(_FreeSlot)) { 
+      _reset(); 
+   }
+
+   _NodePool(_NodePool&& other): 
+      _slabs(std::move(other._slabs)), _slot_size(other._slot_size) {
+      _slab_slots = other._slab_slots;
+      _bump = other._bump;
+      _free_list = other._free_list;
+      _stats = other._stats;
+      other._slabs.clear();
+      other._reset();
+   }
+
+   _NodePool& operator=(_NodePool&& other) {
+      _slabs = std::move(other._slabs);
+      _slot_size = other._slot_size;
+      _slab_slots = other._slab_slots;
+      _bump = other._bump;
+      _free_list = other._free_list;
+      _stats = other._stats;
+      other._slabs.clear();
+      other._reset();
+      return *this;
+   }
 
-      template <typename U>
-      using AVLNode = Vindex::AVLNode<U>;
+   template <typename... Args>
+   NodeTy* create(Args&&... args) {
+      void* slot = _take_slot();
+      NodeTy* n = new (slot) NodeTy(std::forward<Args>(args)...);
+      ++_stats.live;
+      return n;
+   }
 
-      template <typename U>
-      using AVLNodeOwner = Vindex::AVLNodeOwner<U>;
+   void destroy(NodeTy* n) {
+      n->~NodeTy();
+      _FreeSlot* slot = new (n) _FreeSlot;
+      slot->next = _free_list;
+      _free_list = slot;
+      --_stats.live;
+      ++_stats.free;
+   }
 
-      typedef 
-         typename 
-         Vindex<KeyTy, T>::template NodeList<T&>::const_iterator 
-         NodeListIter;
+   void release() {
+      _slabs.clear();
+      _reset();
+   }
 
-      typedef 
-         typename 
-         Vindex<KeyTy, T>::template NodeList<T&>::const_reverse_iterator 
-         NodeListRevIter;
+   // Drops this pool's slabs and allocates ones of the same sizes as 
+   // other's, with the same slots taken and free. Callers construct the 
+   // copy of each of other's nodes at the address Relocation gives.
+   void mirror(const _NodePool& other) {
+      assert(_slot_size == other._slot_size, "MismatchError");
+      release();
+      size_t slab_slots = 0;
+      for (size_t i = 0; i < other._slabs.size(); ++i) {
+         slab_slots = _next_slab_slots(slab_slots);
+         _slabs.emplace_back(new char[slab_slots * _slot_size]);
+      }
+      _slab_slots = other._slab_slots;
+      _bump = other._bump;
+      _stats = other._stats;
 
-      typedef 
-         typename 
-            std::conditional<reverse, NodeListRevIter, NodeListIter>::type 
-         IterTy;
+      const Relocation moved(other, *this);
+      _FreeSlot** tail = &_free_list;
+      for (_FreeSlot* slot = other._free_list; slot; slot = slot->next) {
+         *tail = new (moved(slot)) _FreeSlot;
+         tail = &(*tail)->next;
+      }
+      *tail = nullptr;
+   }
 
-      typedef _IterTracker::IterTracker<T, KeyTy, IterTy> IterTracker;
+   const NodePoolStats& stats() const {
+      return _stats;
+   }
+};
 
-      AVLNode<T&>* _curr;
-      AVLNode<T&>* _prev;
-      bool _prev_incr;
-      OrderType _order_ty;
-      Comparator* _cmp; 
+// Open-addressing (linear probing) table from key hash to node. Keys are 
+// not stored; callers pass a predicate that compares against the node's 
+// key, which is only consulted on a full hash match.
+template <typename NodeTy>
+class _FlatIndex {
+public:
+   struct Slot {
+      size_t hash;
+      NodeTy* node;
 
-      int _curr_lv;
-      int _prev_lv;
+      Slot(): hash(0), node(nullptr) {}
+   };
 
-      IterTracker _tracker;
+private:
+   static const size_t MIN_CAPACITY = 16;
 
-      AVLNode<T&>* _get_leftest_node(AVLNode<T&>* tree) {
-         return tree->left ? _get_leftest_node(tree->left_raw()) : tree;
-      }
+   std::unique_ptr<Slot[]> _slots;
+   size_t _capacity;
+   size_t _shift;
+   size_t _size;
 
-      AVLNode<T&>* _get_rightest_node(AVLNode<T&>* tree) {
-         return tree->right ? _get_rightest_node(tree->right_raw()) : tree;
-      }
+   _FlatIndex(const _FlatIndex&) = delete;
+   _FlatIndex& operator=(const _FlatIndex&) = delete;
 
-      AVLNode<T&>* _get_right_deepest_node(AVLNode<T&>* tree) {
-         if (tree->right)
-            return _get_right_deepest_node(tree->right_raw());
-         else if (tree->left)
-            return _get_right_deepest_node(tree->left_raw());
-         else
-            return tree;
-      }
+   void _reset() {
+      _capacity = 0;
+      _shift = 0;
+      _size = 0;
+   }
 
-      AVLNode<T&>* _get_deepest_right_node_recurs(
-         AVLNode<T&>* tree, int* curr_lv=nullptr) {
-         AVLNode<T&>* left = tree->left_raw();
-         AVLNode<T&>* right = tree->right_raw();
+   size_t _home(size_t hash) const {
+      return (hash * static_cast<size_t>(0x9E3779B97F4A7C15ULL)) >> _shift;
+   }
 
-         if (curr_lv)
-            ++*curr_lv;
+   size_t _next(size_t i) const {
+      return (i + 1) & (_capacity - 1);
+   }
 
-         if (left && right) {
-            return right->height >= left->height ?
-               _get_deepest_right_node_recurs(right, curr_lv) :
-               _get_deepest_right_node_recurs(left, curr_lv);
-         }
-         else if (right)
-            return _get_deepest_right_node_recurs(right, curr_lv);
-         else if (left)
-            return _get_deepest_right_node_recurs(left, curr_lv);
-         else
-            return tree;
-      }
+   static bool _fits(size_t size, size_t capacity) {
+      return size * 4 <= capacity * 3;
+   }
 
-      AVLNode<T&>* _get_deepest_right_node(
-         AVLNode<T&>* tree, int* curr_lv=nullptr) {
-         if (curr_lv)
-            *curr_lv = 0;
-         return _get_deepest_right_node_recurs(tree, curr_lv);
-      }
+   void _rehash(size_t capacity) {
+      std::unique_ptr<Slot[]> old(std::move(_slots));
+      size_t old_capacity = _capacity;
 
-      AVLNode<T&>* _get_root_node(AVLNode<T&>* tree) {
-         return tree;
-      }
+      _slots.reset(new Slot[capacity]);
+      _capacity = capacity;
+      _shift = sizeof(size_t) * 8;
+      for (; capacity > 1; capacity >>= 1)
+         --_shift;
 
-      AVLNode<T&>* _get_left_sibling(AVLNode<T&>* tree) {
-         assert(tree && tree->parent, "NullPointerError");
-         AVLNode<T&>* parent = tree->parent;
-         return parent->right_raw() == tree ? parent->left_raw() : nullptr;
+      for (size_t i = 0; i < old_capacity; ++i) {
+         if (!old[i].node)
+            continue;
+         size_t j = _home(old[i].hash);
+         while (_slots[j].node)
+            j = _next(j);
+         _slots[j] = old[i];
       }
+   }
 
-      AVLNode<T&>* _get_right_sibling(AVLNode<T&>* tree) {
-         assert(tree && tree->parent, "NullPointerError");
-         AVLNode<T&>* parent = tree->parent;
-         return parent->left_raw() == tree ? parent->right_raw() : nullptr;
-      }
+public:
+   _FlatIndex() { 
+      _reset(); 
+   }
 
-      bool _visited_subtree(AVLNode<T&>* subtree) {
-         AVLNode<T&>* child = subtree; 
+   _FlatIndex(_FlatIndex&& other): _slots(std::move(other._slots)) {
+      _capacity = other._capacity;
+      _shift = other._shift;
+      _size = other._size;
+      other._reset();
+   }
 
-         while (child) {
-            if (child == _prev)
-               return true;
-            child = _cmp->lt(_prev->data, child->data) ? 
-               child->left_raw() : child->right_raw();
-         }
-         return false;
-      }
+   _FlatIndex& operator=(_FlatIndex&& other) {
+      _slots = std::move(other._slots);
+      _capacity = other._capacity;
+      _shift = other._shift;
+      _size = other._size;
+      other._reset();
+      return *this;
+   }
 
-      bool _visited_left_subtree() {
-         return _curr ? _visited_subtree(_curr->left_raw()) : false; 
-      }
+   template <typename MatchFn>
+   const Slot* find(size_t hash, const MatchFn& match) const {
+      if (!_size)
+         return nullptr;
+      for (size_t i = _home(hash); _slots[i].node; i = _next(i))
+         if (_slots[i].hash == hash && match(_slots[i].node))
+            return &_slots[i];
+      return nullptr;
+   }
 
-      bool _visited_right_subtree() {
-         return _curr ? _visited_subtree(_curr->right_raw()) : false; 
-      }
+   template <typename MatchFn>
+   Slot* find(size_t hash, const MatchFn& match) {
+      return const_cast<Slot*>(
+         static_cast<const _FlatIndex*>(this)->find(hash, match));
+   }
 
-      bool _visited_sibling_subtree() {
-         if (!_curr || !_curr->parent)
-            return false;
+   // Returns the slot holding the matching node, or the empty slot it 
+   // would occupy; in the latter case fill it with occupy().
+   template <typename MatchFn>
+   Slot* probe(size_t hash, const MatchFn& match) {
+      if (!_fits(_size + 1, _capacity))
+         _rehash(_capacity ? _capacity * 2 : MIN_CAPACITY);
 
-         AVLNode<T>* parent = _curr->parent;
-         return parent->left_raw() == _curr ?
-            _visited_subtree(parent->right_raw()) :
-            _visited_subtree(parent->left_raw());
-      }
+      size_t i = _home(hash);
+      for (; _slots[i].node; i = _next(i))
+         if (_slots[i].hash == hash && match(_slots[i].node))
+            break;
+      return &_slots[i];
+   }
 
-      bool _visited_parent() {
-         if (!_curr)
-            return false;
+   void occupy(Slot* slot, size_t hash, NodeTy* n) {
+      slot->hash = hash;
+      slot->node = n;
+      ++_size;
+   }
 
-         AVLNode<T&>* parent = _curr->parent;
-         while (parent) {
-            if (_prev == parent)
-               return true;
-            parent = parent->parent;
-         }
-         return false;
-      }
+   void erase(Slot* slot) {
+      const size_t mask = _capacity - 1;
+      size_t hole = slot - _slots.get();
 
-      AVLNode<T&>* _retrace_while_child(
-         AVLNode<T&>* n, Direction dir, int* parent_distance=nullptr) {
-         if (!n->parent)
-            return nullptr;
-         
-         assert(n && n->parent, "NullPointerError");
-
-         int dist = 0;
-         AVLNode<T&>* parent = n->parent;
-         AVLNodeOwner<T&>* parents_child = dir == Direction::RIGHT ? 
-            &parent->right : &parent->left;
-
-         while (parent && parents_child->get() == n) {
-            ++dist;
-            n = n->parent;
-            parent = n->parent;
-            parents_child = dir == Direction::RIGHT ? 
-               &parent->right : &parent->left;
+      for (size_t i = _next(hole); _slots[i].node; i = _next(i)) {
+         size_t home = _home(_slots[i].hash);
+         if (((i - home) & mask) >= ((i - hole) & mask)) {
+            _slots[hole] = _slots[i];
+            hole = i;
          }
-         if (parent_distance)
-            *parent_distance = dist + 1;
-         return parent;
       }
+      _slots[hole] = Slot();
+      --_size;
+   }
 
-      AVLNode<T&>* _retrace_until_unvisited_right_child() {
-         AVLNode<T&>* n = _retrace_while_child(_curr, Direction::RIGHT);
-         return n ? (n->right ? n->right_raw() : nullptr) : nullptr;
+   // Copies other's table slot for slot and passes each node through 
+   // relocate, so nothing is rehashed.
+   template <typename RelocateFn>
+   void assign(const _FlatIndex& other, const RelocateFn& relocate) {
+      _slots.reset(other._capacity ? new Slot[other._capacity] : nullptr);
+      for (size_t i = 0; i < other._capacity; ++i) {
+         _slots[i].hash = other._slots[i].hash;
+         _slots[i].node = relocate(other._slots[i].node);
       }
+      _capacity = other._capacity;
+      _shift = other._shift;
+      _size = other._size;
+   }
+
+   void reserve(size_t size) {
+      size_t capacity = MIN_CAPACITY;
+      while (!_fits(size, capacity))
+         capacity *= 2;
+      if (capacity > _capacity)
+         _rehash(capacity);
+   }
 
-      AVLNode<T&>* _retrace_until_left_child() {
-         assert(_curr && _curr->parent, "NullPointerError");
+   template <typename Fn>
+   void for_each(const Fn& fn) {
+      for (size_t i = 0; i < _capacity; ++i)
+         if (_slots[i].node)
+            fn(_slots[i]);
+   }
 
-         AVLNode<T&>* curr = _curr;
-         AVLNode<T&>* parent = curr->parent;
+   template <typename Fn>
+   void for_each(const Fn& fn) const {
+      for (size_t i = 0; i < _capacity; ++i)
+         if (_slots[i].node)
+            fn(static_cast<const Slot&>(_slots[i]));
+   }
 
-         while (parent && !parent->left) {
-            curr = curr->parent;
-            parent = curr->parent;
-         }
-         return parent->left_raw();
-      }
+   void clear() {
+      std::fill(_slots.get(), _slots.get() + _capacity, Slot());
+      _size = 0;
+   }
 
-      AVLNode<T&>* _retrace_until_unvisited_left_child() {
-         AVLNode<T&>* n = _retrace_while_child(_curr, Direction::LEFT);
-         return n ? (n->left ? n->left_raw() : nullptr) : nullptr;
-      }
+   size_t size() const {
+      return _size;
+   }
 
-      void _in_order_increment() {
-         AVLNode<T&>* tmp = _curr;
-         if (!_prev_incr)
-            _curr = _prev;   
-         else if (_visited_left_subtree() || _visited_parent() || !_prev)
-            _curr = tmp->right ? 
-               _get_leftest_node(tmp->right_raw()) : 
-               _retrace_while_child(_curr, Direction::RIGHT);
-         else if (_visited_right_subtree())
-            assert(false, "InvalidAdvanceStateError");
-         else if (!_curr)
-            return;
-         else
-            assert(false, "InvalidAdvanceStateError");
+   size_t capacity() const {
+      return _capacity;
+   }
+};
 
-         _prev = tmp;
-      }
+template <typename T>
+class _Heads {
+public:
+   typedef IComparator<T> Comparator;
+   typedef _MultiTreeNode<T> Node;
 
-      void _in_order_decrement() {
-         AVLNode<T&>* tmp = _curr;
-         if (_prev_incr)
-            _curr = _prev;
-         else if (_visited_right_subtree() || _visited_parent() || !_prev)
-            _curr = tmp->left ?
-               _get_rightest_node(tmp->left_raw()) : 
-               _retrace_while_child(_curr, Direction::LEFT);
-         else if (!_curr)
-            return;
-         else
-            assert(false, "InvalidAdvanceStateError");
+   struct Head {
+      Comparator* cmp;
+      Node* root;
+      size_t slot;
 
-         _prev = tmp;
-      }
+      Head(): cmp(nullptr), root(nullptr), slot(0) {}
 
-      void _pre_order_increment() {
-         AVLNode<T&>* tmp = _curr;   
+      Head(Comparator* cmp, size_t slot): 
+         cmp(cmp), root(nullptr), slot(slot) {}
+   };
 
-         if (!_prev_incr)
-            _curr = _prev;
-         else if (tmp) {
-            if (tmp->left)
-               _curr = _get_root_node(tmp->left_raw());
-            else if (tmp->right)
-               _curr = _get_root_node(tmp->right_raw());
-            else
-               _curr = _retrace_until_unvisited_right_child();
-         }
-         else if (!tmp)
-            return;
-         else
-            assert(false, "InvalidAdvanceStateError");
+private:
+   typedef std::unique_ptr<Comparator> ComparatorOwner; 
+   typedef ComparatorOwner (*Cloner)(const Comparator&);
+
+   std::vector<ComparatorOwner> _comparators;
+   std::vector<Cloner> _cloners;
+   std::vector<Head> _heads;
+
+public:
+   typedef typename std::vector<Head>::iterator iterator;
 
-         _prev = tmp;
+private:
+   // Linear scan comparing typeid first; meant for the handful of heads a 
+   // vindex has. BasicVindex resolves static comparators without it.
+   template <typename CmpTy>
+   size_t _slot_of(const CmpTy& cmp) const {
+      for (size_t slot = 0; slot < _heads.size(); ++slot) {
+         const Comparator& other = *_heads[slot].cmp;
+         if (typeid(other) == typeid(cmp) && cmp == other)
+            return slot;
       }
+      return _heads.size();
+   }
 
-      void _pre_order_decrement() {
-         AVLNode<T&>* tmp = _curr;
+   template <typename CmpTy>
+   static ComparatorOwner _clone(const Comparator& cmp) {
+      return std::make_unique<CmpTy>(static_cast<const CmpTy&>(cmp));
+   }
 
-         if (_prev_incr)
-            _curr = _prev;
-         else if (tmp) { 
-            if (tmp->parent && tmp->parent->right_raw() == tmp) {
-               AVLNode<T&>* left_sibling = _get_left_sibling(tmp);
-               _curr = left_sibling ? 
-                  _get_right_deepest_node(left_sibling) : tmp->parent;
-            }
-            else if (!tmp->parent || tmp->parent->left_raw() == tmp)
-               _curr = tmp->parent;
-            else
-               assert(false, "InvalidAdvanceStateError");
-         }
-         else if (!tmp)
-            return;
-         else
-            assert(false, "InvalidAdvanceStateError");
+public:
+   _Heads() {}
 
-         _prev = tmp;
+   // Copies the comparators into empty heads at the same slots.
+   _Heads(const _Heads& other): _cloners(other._cloners) {
+      for (size_t slot = 0; slot < other._heads.size(); ++slot) {
+         _comparators.emplace_back(_cloners[slot](*other._heads[slot].cmp));
+         _heads.emplace_back(_comparators.back().get(), slot);
       }
+   }
 
-      void _post_order_increment() {
-         AVLNode<T&>* tmp = _curr;
+   _Heads(_Heads&& other): 
+      _comparators(std::move(other._comparators)), 
+      _cloners(std::move(other._cloners)), 
+      _heads(std::move(other._heads)) {
+      other._comparators.clear();
+      other._cloners.clear();
+      other._heads.clear();
+   };
 
-         if (!_prev_incr)
-            _curr = _prev;
-         else if (tmp) {
-            if (tmp->parent && tmp->parent->left_raw() == tmp) {
-               AVLNode<T&>* right_sibling = _get_right_sibling(tmp);
-               _curr = right_sibling ?
-                  _get_leftest_node(right_sibling) : tmp->parent;
-            }
-            else if (!tmp->parent || tmp->parent->right_raw() == tmp)
-               _curr = tmp->parent;
-            else
-               assert(false, "InvalidAdvanceStateError");
-         }
-         else if (!tmp)
-            return;
-         else
-            assert(false, "InvalidAdvanceStateError");
+   _Heads& operator=(_Heads&& other) {
+      _comparators = std::move(other._comparators);
+      _cloners = std::move(other._cloners);
+      _heads = std::move(other._heads);
+      other._comparators.clear();
+      other._cloners.clear();
+      other._heads.clear();
+      return *this;
+   }
+
+   template <typename CmpTy>
+   void push(const CmpTy& cmp) { 
+      if (exists(cmp))
+         return;
+      _comparators.emplace_back(std::make_unique<CmpTy>(cmp));
+      _cloners.push_back(&_Heads::_clone<CmpTy>);
+      _heads.emplace_back(_comparators.back().get(), _heads.size());
+   }
+
+   template <typename CmpTy>
+   const Head* find(const CmpTy& cmp) const {
+      size_t slot = _slot_of(cmp);
+      return slot < _heads.size() ? &_heads[slot] : nullptr;
+   }
+
+   template <typename CmpTy>
+   Head* find(const CmpTy& cmp) {
+      size_t slot = _slot_of(cmp);
+      return slot < _heads.size() ? &_heads[slot] : nullptr;
+   }
+
+   Head* primary() {
+      return _heads.empty() ? nullptr : &_heads.front();
+   }
+
+   const Head* at(size_t slot) const {
+      return slot < _heads.size() ? &_heads[slot] : nullptr;
+   }
+
+   Head* at(size_t slot) {
+      return slot < _heads.size() ? &_heads[slot] : nullptr;
+   }
+
+   iterator begin(size_t first_slot = 1) {
+      return first_slot < _heads.size() ? 
+         _heads.begin() + first_slot : _heads.end();
+   }
+
+   iterator end() {
+      return _heads.end();
+   }
+
+   template <typename CmpTy>
+   bool exists(const CmpTy& cmp) const {
+      return _slot_of(cmp) < _heads.size();
+   }
+
+   size_t size() const {
+      return _heads.size();
+   }
+};
+
+template <
+   typename KeyTy, typename T, typename ExtractorTy, typename... Cmps>
+class BasicVindex {
+   static_assert(
+      !std::is_lvalue_reference<T>::value && !std::is_pointer<T>::value, 
+      "T cannot be an lvalue reference");
+   static_assert(_all_distinct<DefaultComparator<T>, Cmps...>::value,
+      "Cmps must be distinct and exclude DefaultComparator<T>");
+private:
+   friend class TestIntVindex;
+   template <typename> friend class ShardedVindex;
+   template <typename> friend class ParallelVindex;
+
+   typedef _Direction::Direction Direction;
+   typedef OrderType::OrderType OrderType;
+   typedef std::function<void()> VoidFunc;
+   typedef ExtractorTy Extractor;
+   typedef std::map<OrderType, std::string> OrderTypeToStr;
+   typedef typename _Heads<T>::Comparator Comparator;
+   typedef typename _Heads<T>::Head Head;
+
+public:
+   class const_iterator;
+   class const_reverse_iterator;
+
+   typedef typename _Heads<T>::Node Node;
+   typedef std::list<Node*> NodeList;
+   typedef _InsertionList<Node> InsertionList;
+
+private:
+   typedef _NodePool<Node> NodePool;
+   typedef std::deque<Node*> NodeDQ;
+   typedef std::function<void(Node*)> NodeListener;
+
+   typedef _FlatIndex<Node> Index;
+   typedef typename Index::Slot IndexSlot;
+
+   struct KeyMatch {
+      const _Reassignable<Extractor>& get_member;
+      const KeyTy& key;
+
+      bool operator()(const Node* n) const {
+         return get_member(n->data) == key;
+      }
+   };
 
-         _prev = tmp;
+   class OrderTypeToStrSingleton : 
+      public _Singleton<OrderTypeToStr, OrderTypeToStrSingleton> {
+   public:
+      static void init(OrderTypeToStr* order_ty_to_str) {
+         (*order_ty_to_str)[OrderType::INORDER] = "INORDER";
+         (*order_ty_to_str)[OrderType::PREORDER] = "PREORDER";
+         (*order_ty_to_str)[OrderType::POSTORDER] = "POSTORDER";
+         (*order_ty_to_str)[OrderType::BREADTHFIRST] = "BREADTHFIRST";
+         (*order_ty_to_str)[OrderType::INSERTION] = "INSERTION";
       }
+   }; 
 
-      void _post_order_decrement() {
-         AVLNode<T&>* tmp = _curr;
+   struct NodeDefaultSingleton :
+      public _Singleton<_Node<T>, NodeDefaultSingleton> {
+      static void init(_Node<T>*) {}
+   };
 
-         if (_prev_incr)
-            _curr = _prev;
-         else if (tmp) {
-            if (tmp->right)
-               _curr = _get_root_node(tmp->right_raw());
-            else if (tmp->left)
-               _curr = _get_root_node(tmp->left_raw());
-            else if (tmp->parent && tmp->parent->right_raw() == tmp)
-               _curr = _get_root_node(_retrace_until_left_child());
-            else if (tmp->parent && tmp->parent->left_raw() == tmp)
-               _curr = _get_root_node(_retrace_until_unvisited_left_child());
-            else
-               assert(false, "InvalidAdvanceStateError");
-         }
-         else if (!tmp)
-            return;
-         else
-            assert(false, "InvalidAdvanceStateError");
+   struct DefaultComparatorSingleton:
+      public _Singleton<DefaultComparator<T>, DefaultComparatorSingleton> {
+      static void init(DefaultComparator<T>*) {}
+   };
+
+   // Trivially copyable and two words wide: the node plus packed slot, 
+   // depth (BREADTHFIRST only), order type and edge state.
+   template <bool reverse>
+   class _const_iterator {
+   public:
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const T* pointer;
+      typedef const T& reference;
 
-         _prev = tmp;
+   private:
+      typedef typename BasicVindex::Direction Direction;
+      typedef typename _Heads<T>::Head Head;
+
+      typedef typename BasicVindex::Node Node;
+      typedef typename BasicVindex::InsertionList InsertionList;
+
+      // Past either end _curr keeps the node stepped off from, so that 
+      // stepping back re-enters there.
+      enum Edge { ON_NODE, BEFORE_FIRST, PAST_LAST };
+
+      Node* _curr;
+      uint32_t _slot;
+      uint16_t _curr_lv;
+      uint8_t _order_ty;
+      uint8_t _edge;
+
+      Node* _get_leftest_node(Node* tree) {
+         return tree->left(_slot) ? 
+            _get_leftest_node(tree->left(_slot)) : tree;
       }
 
-      AVLNode<T&>* _get_node_at_depth(
-         AVLNode<T&>* tree, int tree_lv, int want_lv, Direction dir) {
-         if (!tree || tree_lv > want_lv)
-            return nullptr;
-         else if (tree_lv == want_lv)
-            return tree;
-         else if (tree_lv < want_lv) {
-            AVLNode<T&>* n = _get_node_at_depth(
-               dir == Direction::RIGHT ? tree->right_raw() : tree->left_raw(), 
-               tree_lv + 1, want_lv, dir);
-            if (!n)
-               n = _get_node_at_depth(
-                  dir == Direction::RIGHT ? 
-                     tree->left_raw() : tree->right_raw(), 
-                  tree_lv + 1, want_lv, dir);
-            return n;
-         }
-         else
-            assert(false, "InvalidOperationError");
+      Node* _get_rightest_node(Node* tree) {
+         return tree->right(_slot) ? 
+            _get_rightest_node(tree->right(_slot)) : tree;
       }
 
-      AVLNode<T&>* _get_leftest_node_at_depth(
-         AVLNode<T&>* tree, int tree_lv, int want_lv) {
-         return _get_node_at_depth(tree, tree_lv, want_lv, Direction::LEFT);
+      Node* _child(Node* n, Direction dir) const {
+         return dir == Direction::LEFT ? n->left(_slot) : n->right(_slot);
       }
 
-      AVLNode<T&>* _get_rightest_node_at_depth(
-         AVLNode<T&>* tree, int tree_lv, int want_lv) {
-         return _get_node_at_depth(tree, tree_lv, want_lv, Direction::RIGHT);
+      static Direction _opposite(Direction dir) {
+         return dir == Direction::LEFT ? Direction::RIGHT : Direction::LEFT;
       }
 
-      void _get_next_sibling_positions(
-         AVLNode<T&>* parent, Direction dir, 
-         AVLNode<T&>** pos1, AVLNode<T&>** pos2) {
-         if (dir == Direction::RIGHT) {
-            *pos1 = parent->left_raw();
-            *pos2 = parent->right_raw();
-         }
-         else if (dir == Direction::LEFT) {
-            *pos1 = parent->right_raw();
-            *pos2 = parent->left_raw();
-         }
-         else
-            assert(false, "InvalidOperationError");
-      }
-
-      AVLNode<T&>* _get_next_sibling(AVLNode<T&>* n, int depth, Direction dir) {
-         assert(n, "NullPointerError");
-
-         AVLNode<T&>* parent = n->parent;
-
-         if (parent) {
-            AVLNode<T&>* pos1 = nullptr;
-            AVLNode<T&>* pos2 = nullptr;
-            _get_next_sibling_positions(parent, dir, &pos1, &pos2);
-
-            if (pos1 == n && pos2)
-               return pos2;
-            else if (pos2 == n) {
-               int parent_distance = 0;
-               parent = _retrace_while_child(n, dir, &parent_distance);
-
-               return parent ? 
-                  (dir == Direction::RIGHT ?
-                     _get_leftest_node_at_depth(
-                        parent->right_raw(),
-                        depth - parent_distance + 1,
-                        depth) :
-                     _get_rightest_node_at_depth(
-                        parent->left_raw(),
-                        depth - parent_distance + 1,
-                        depth)
-                  ) : nullptr;
-            }
+      // Descends towards `last` whenever possible, else towards the other 
+      // side, down to a leaf.
+      Node* _get_deepest_node(Node* tree, Direction last) const {
+         for (;;) {
+            if (_child(tree, last))
+               tree = _child(tree, last);
+            else if (_child(tree, _opposite(last)))
+               tree = _child(tree, _opposite(last));
             else
-               assert(false, "InvalidOperationError");
+               return tree;
          }
-         else
-            return nullptr;
       }
 
-      AVLNode<T&>* _get_start_node(
-         AVLNode<T&>* refnode, int depth, Direction dir) {
-         AVLNode<T&>* n = refnode;
-         AVLNode<T&>* prev = nullptr;
-         assert(dir != Direction::ROOT, "InvalidDirectionError");
-
-         do {
-            prev = n;
-            n = _get_next_sibling(n, depth, dir);
-         } while (n);
-         return prev;
+      Node* _get_root_node(Node* tree) {
+         return tree;
       }
 
-      AVLNode<T&>* _get_first_node_on_lower_lv(AVLNode<T&>* refnode) {
-         ++_curr_lv;
-         AVLNode<T&>* n = 
-            _get_start_node(refnode, _curr_lv - 1, Direction::LEFT);
-
-         do {
-            AVLNode<T&>* first = n->left_raw();
-            AVLNode<T&>* second = n->right_raw();
-
-            if (first)
-               return first;
-            else if (second)
-               return second;
-            n = _get_next_sibling(n, _curr_lv - 1, Direction::RIGHT);
-         } while (n);
+      // In-order successor (dir == RIGHT) or predecessor (dir == LEFT).
+      Node* _in_order_step(Node* n, Direction dir) const {
+         if (_child(n, dir)) {
+            n = _child(n, dir);
+            while (_child(n, _opposite(dir)))
+               n = _child(n, _opposite(dir));
+            return n;
+         }
 
-         --_curr_lv;
-         return nullptr;
+         Node* parent = n->parent(_slot);
+         while (parent && _child(parent, dir) == n) {
+            n = parent;
+            parent = n->parent(_slot);
+         }
+         return parent;
       }
 
-      AVLNode<T&>* _get_first_node_on_upper_lv(AVLNode<T&>* refnode) {
-         if (refnode) {
-            --_curr_lv;
-            return _get_start_node(refnode, _curr_lv - 1, Direction::RIGHT);
+      // Pre-order successor (first == LEFT); mirrored (first == RIGHT) it 
+      // is the post-order predecessor.
+      Node* _pre_order_step(Node* n, Direction first) const {
+         const Direction second = _opposite(first);
+         if (_child(n, first))
+            return _child(n, first);
+         if (_child(n, second))
+            return _child(n, second);
+
+         Node* parent = n->parent(_slot);
+         while (parent && 
+            (_child(parent, second) == n || !_child(parent, second))) {
+            n = parent;
+            parent = n->parent(_slot);
          }
-         else
-            return nullptr;
+         return parent ? _child(parent, second) : nullptr;
       }
 
-      void _swap(int* a, int* b) {
-         int tmp = *a;
-         *a = *b;
-         *b = tmp;
+      // Inverse of _pre_order_step: pre-order predecessor (first == LEFT) 
+      // or post-order successor (first == RIGHT).
+      Node* _pre_order_step_back(Node* n, Direction first) const {
+         Node* parent = n->parent(_slot);
+         if (!parent || _child(parent, first) == n || !_child(parent, first))
+            return parent;
+         return _get_deepest_node(_child(parent, first), _opposite(first));
       }
 
-      void _breadth_first_increment() {
-         AVLNode<T&>* tmp = _curr;
+      Node* _step(Node* n, bool forward) {
+         const Direction dir = forward ? Direction::RIGHT : Direction::LEFT;
 
-         if (!_prev_incr) {
-            _curr = _prev;
-            _swap(&_curr_lv, &_prev_lv);
-         }
-         else if (tmp) {
-            _curr = _get_next_sibling(tmp, _curr_lv, Direction::RIGHT);
-            if (!_curr) {
-               _prev_lv = _curr_lv;
-               _curr = _get_first_node_on_lower_lv(tmp);
-            }
-         }
-         else if (!tmp)
-            return;
+         if (_order_ty == OrderType::INORDER)
+            return _in_order_step(n, dir);
+         else if (_order_ty == OrderType::PREORDER)
+            return forward ? 
+               _pre_order_step(n, Direction::LEFT) : 
+               _pre_order_step_back(n, Direction::LEFT);
+         else if (_order_ty == OrderType::POSTORDER)
+            return forward ? 
+               _pre_order_step_back(n, Direction::RIGHT) : 
+               _pre_order_step(n, Direction::RIGHT);
+         else if (_order_ty == OrderType::BREADTHFIRST)
+            return _breadth_first_step(n, forward);
+         else if (_order_ty == OrderType::INSERTION)
+            return forward ? n->next_inserted : n->prev_inserted;
          else
-            assert(false, "InvalidAdvanceStateError");
-
-         _prev = tmp;
+            assert(false, "NotYetImplementedError");
+         return nullptr;
       }
 
-      void _breadth_first_decrement() {
-         AVLNode<T&>* tmp = _curr;
-
-         if (_prev_incr) {
-            _curr = _prev;
-            _swap(&_curr_lv, &_prev_lv);
-         }
-         else if (tmp) {
-            _curr = _get_next_sibling(tmp, _curr_lv, Direction::LEFT);
-            if (!_curr) {
-               _prev_lv = _curr_lv;
-               _curr = _get_first_node_on_upper_lv(tmp->parent);
-            }
+      void _advance(bool forward) {
+         if (_edge != ON_NODE) {
+            if (_edge == (forward ? BEFORE_FIRST : PAST_LAST))
+               _edge = ON_NODE;
+            return;
          }
-         else if (!tmp)
+         if (!_curr)
             return;
+
+         Node* next = _step(_curr, forward);
+         if (next)
+            _curr = next;
          else
-            assert(false, "InvalidAdvanceStateError");
+            _edge = forward ? PAST_LAST : BEFORE_FIRST;
+      }
 
-         _prev = tmp;
+      Node* _node() const {
+         return _edge == ON_NODE ? _curr : nullptr;
       }
 
-      void _insertion_order_advance(bool towards_end) {
-         if (towards_end) {
-            if (_tracker.curr() == _tracker.end())
-               _curr = nullptr;
-            else if (!_curr)
-               _curr = *_tracker.curr();
-            else {
-               ++_tracker.curr();
-               _curr = _tracker.curr() == _tracker.end() ? 
-                  nullptr : *_tracker.curr();
-            }
-         }
-         else
-            _curr = _tracker.curr() == _tracker.begin() ? 
-               nullptr : *--_tracker.curr();
+      // Deepest depth reached by `tree`, which sits at depth `lv`.
+      int _reach(Node* tree, int lv) const {
+         return lv + static_cast<int>(tree->height(_slot)) - 1;
       }
 
-      void _insertion_order_increment() {
-         reverse ?
-            _insertion_order_advance(/*towards_end=*/false) :
-            _insertion_order_advance(/*towards_end=*/true);
+      // First node at depth `want_lv` within `tree` (at depth `lv`) when 
+      // scanning the level towards `dir`; `tree` must reach `want_lv`.
+      Node* _descend_to_depth(
+         Node* tree, int lv, int want_lv, Direction dir) const {
+         for (; lv < want_lv; ++lv) {
+            Node* first = _child(tree, _opposite(dir));
+            tree = first && _reach(first, lv + 1) >= want_lv ? 
+               first : _child(tree, dir);
+         }
+         return tree;
       }
 
-      void _insertion_order_decrement() {
-         reverse ?
-            _insertion_order_advance(/*towards_end=*/true) :
-            _insertion_order_advance(/*towards_end=*/false);
+      // Breadth-first successor (forward) or predecessor. Subtrees that do 
+      // not reach the wanted depth are skipped by height, so a full level 
+      // costs time proportional to the paths leading into it.
+      Node* _breadth_first_step(Node* n, bool forward) {
+         const Direction dir = forward ? Direction::RIGHT : Direction::LEFT;
+         int lv = _curr_lv;
+
+         for (Node* parent = n->parent(_slot); parent; 
+            n = parent, parent = n->parent(_slot)) {
+            --lv;
+            Node* next = _child(parent, dir);
+            if (next && next != n && _reach(next, lv + 1) >= _curr_lv)
+               return _descend_to_depth(next, lv + 1, _curr_lv, dir);
+         }
+
+         const int want_lv = forward ? _curr_lv + 1 : _curr_lv - 1;
+         if (want_lv < 1 || _reach(n, 1) < want_lv)
+            return nullptr;
+         _curr_lv = want_lv;
+         return _descend_to_depth(n, 1, want_lv, dir);
       }
 
-      std::string _node_data(AVLNode<T>* n) const {
+      std::string _node_data(Node* n) const {
          using namespace std;
          stringstream ss;
          if (n)
@@ -1101,18 +1271,24 @@ private:
          using namespace std;
          stringstream ss;
          ss << "curr: " << _curr << " = " << _node_data(_curr) << endl;
-         ss << "prev: " << _prev << " = " << _node_data(_prev) << endl;
+         ss << "edge: " << static_cast<int>(_edge) << endl;
          ss << boolalpha;
-         ss << "prev_incr: " << _prev_incr << endl;
          ss << "reverse: " << reverse << endl;
-         ss << "order_ty: " << _order_type_name(_order_ty) << endl;
+         ss << "order_ty: " 
+            << _order_type_name(static_cast<OrderType>(_order_ty)) << endl;
          ss << "curr_lv: " << _curr_lv << endl;
          return ss.str();
       }
 
-      AVLNode<T&>* _init_curr(const AVLNodeOwner<T&>& head) {
-         AVLNode<T&>* raw_head = head.get();
-         AVLNode<T&>* curr = nullptr;
+      int _depth(Node* n) const {
+         int depth = 0;
+         for (; n; n = n->parent(_slot))
+            ++depth;
+         return depth;
+      }
+
+      Node* _init_curr(Node* raw_head) {
+         Node* curr = nullptr;
 
          if (raw_head) {
             if (_order_ty == OrderType::INORDER)
@@ -1121,21 +1297,17 @@ private:
                   _get_leftest_node(raw_head);
             else if (_order_ty == OrderType::PREORDER)
                curr = reverse ?
-                  _get_rightest_node(raw_head) :
+                  _get_deepest_node(raw_head, Direction::RIGHT) :
                   _get_root_node(raw_head);
             else if (_order_ty == OrderType::POSTORDER)
                curr = reverse ?
                   _get_root_node(raw_head) :
-                  _get_leftest_node(raw_head);
+                  _get_deepest_node(raw_head, Direction::LEFT);
             else if (_order_ty == OrderType::BREADTHFIRST) {
-               curr = reverse ?
-                  _get_deepest_right_node(raw_head, &_curr_lv) :
-                  _get_root_node(raw_head); 
-
-               _curr_lv = reverse ? _curr_lv : 1;
+               _curr_lv = reverse ? _reach(raw_head, 1) : 1;
+               curr = _descend_to_depth(raw_head, 1, _curr_lv, 
+                  reverse ? Direction::LEFT : Direction::RIGHT);
             }
-            else if (_order_ty == OrderType::INSERTION)
-               curr = *_tracker.curr();
             else
                assert(false, "NotYetImplementedError");
          }
@@ -1146,89 +1318,47 @@ private:
    protected:
       _const_iterator(): 
          _curr(nullptr), 
-         _prev(nullptr), 
-         _prev_incr(true), 
+         _slot(0),
+         _curr_lv(0),
          _order_ty(OrderType::INORDER),
-         _cmp(nullptr),
-
-         _curr_lv(0), 
-         _prev_lv(0)
+         _edge(ON_NODE)
          {}
 
-      _const_iterator(const NodeList<T&>& insertion_list, OrderType order_ty):
-         _curr(nullptr), 
-         _prev(nullptr),
-         _prev_incr(reverse ? false : true), 
+      _const_iterator(
+         const InsertionList& insertion_list, OrderType order_ty):
+         _curr(order_ty != OrderType::INSERTION ? nullptr : 
+            reverse ? insertion_list.last : insertion_list.first), 
+         _slot(0),
+         _curr_lv(0),
          _order_ty(order_ty),
-         _cmp(nullptr),
-
-         _curr_lv(0), 
-         _prev_lv(0),
-
-         _tracker(insertion_list) 
-         {}
-
-      _const_iterator(const _const_iterator& other): 
-         _curr(other._curr), 
-         _prev(other._prev), 
-         _prev_incr(other._prev_incr), 
-         _order_ty(other._order_ty), 
-         _cmp(other._cmp),
-
-         _curr_lv(other._curr_lv),
-         _prev_lv(other._prev_lv),
-
-         _tracker(other._tracker) 
+         _edge(ON_NODE)
          {}
 
-      _const_iterator& operator=(const _const_iterator& other) {
-         _curr = other._curr;
-         _prev = other._prev;
-         _prev_incr = other._prev_incr;
-         _order_ty = other._order_ty;
-         _cmp = other._cmp;
-
-         _curr_lv = other._curr_lv;
-         _prev_lv = other._prev_lv;
-
-         _tracker = other._tracker;
-
-         return *this;
+      void _init_curr_from_head(const Head& head) {
+         _slot = head.slot;
+         if (_order_ty != OrderType::INSERTION)
+            _curr = _init_curr(head.root);
       }
 
-      template <typename CmpTy>
-      void _init_curr_from_cmp(const _Heads<T>& heads, const CmpTy& cmp) {
-         auto head = heads.template get<_head_type::node_ref>(cmp);
-         assert(head, 
-            "CmpHead" << typeid(cmp).name() << "EntryDoesNotExistError");
-         _cmp = &head->first;
-         _curr = _init_curr(head->second);
+      void _init_curr_at_node(const Head& head, Node* n) {
+         _slot = head.slot;
+         _curr = n;
+         _edge = ON_NODE;
+         if (_order_ty == OrderType::BREADTHFIRST)
+            _curr_lv = _depth(n);
       }
 
    public:
       bool operator==(const _const_iterator& other) const {
-         return _curr == other._curr;
+         return _node() == other._node();
       }
 
       bool operator!=(const _const_iterator& other) const {
          return !operator==(other);
       }
 
-      _const_iterator operator++() {
-         if (_order_ty == OrderType::INORDER)
-            _in_order_increment();
-         else if (_order_ty == OrderType::PREORDER)
-            _pre_order_increment();
-         else if (_order_ty == OrderType::POSTORDER)
-            _post_order_increment();
-         else if (_order_ty == OrderType::BREADTHFIRST)
-            _breadth_first_increment();
-         else if (_order_ty == OrderType::INSERTION)
-            _insertion_order_increment();
-         else
-            assert(false, "NotYetImplementedError");
-
-         _prev_incr = true;
+      _const_iterator& operator++() {
+         _advance(/*forward=*/true);
          return *this;
       }
 
@@ -1238,21 +1368,8 @@ private:
          return tmp;
       }
 
-      _const_iterator operator--() {
-         if (_order_ty == OrderType::INORDER)
-            _in_order_decrement();
-         else if (_order_ty == OrderType::PREORDER)
-            _pre_order_decrement();
-         else if (_order_ty == OrderType::POSTORDER)
-            _post_order_decrement();
-         else if (_order_ty == OrderType::BREADTHFIRST)
-            _breadth_first_decrement();
-         else if (_order_ty == OrderType::INSERTION)
-            _insertion_order_decrement();
-         else
-            assert(false, "NotYetImplementedError");
-
-         _prev_incr = false;
+      _const_iterator& operator--() {
+         _advance(/*forward=*/false);
          return *this;
       }
 
@@ -1263,11 +1380,13 @@ private:
       }
 
       const T& operator*() const {
-         return _curr ? _curr->data : Vindex<KeyTy, T>::_default()->data;
+         Node* n = _node();
+         return n ? n->data : BasicVindex::_default()->data;
       }
 
       const T* operator->() const {
-         return _curr ? &_curr->data : &Vindex<KeyTy, T>::_default()->data;
+         Node* n = _node();
+         return n ? &n->data : &BasicVindex::_default()->data;
       }
 
       _const_iterator end() const { 
@@ -1289,24 +1408,18 @@ public:
       const_iterator() NOEXCEPT {}
 
       const_iterator(
-         const NodeList<T&>& insertion_list, OrderType order_ty) NOEXCEPT: 
+         const InsertionList& insertion_list, OrderType order_ty) NOEXCEPT: 
          _const_iterator<false>(insertion_list, order_ty) {}
 
-      const_iterator(const const_iterator& other) NOEXCEPT :
-         _const_iterator<false>(other) {}
-
-
-      template <typename CmpTy>
-      void init_from_cmp(const _Heads<T>& heads, const CmpTy& cmp) {
-         _const_iterator<false>::_init_curr_from_cmp(heads, cmp);   
+      void init_from_head(const Head& head) {
+         _const_iterator<false>::_init_curr_from_head(head);   
       }
 
-      const_iterator& operator=(const const_iterator& other) NOEXCEPT {
-         _const_iterator<false>::operator=(other);   
-         return *this;
+      void init_at_node(const Head& head, Node* n) {
+         _const_iterator<false>::_init_curr_at_node(head, n);
       }
 
-      const_iterator operator++() NOEXCEPT {
+      const_iterator& operator++() NOEXCEPT {
          _const_iterator<false>::operator++();
          return *this;
       } 
@@ -1317,7 +1430,7 @@ public:
          return tmp;
       }
 
-      const_iterator operator--() NOEXCEPT {
+      const_iterator& operator--() NOEXCEPT {
          _const_iterator<false>::operator--();
          return *this;
       } 
@@ -1338,24 +1451,14 @@ public:
       const_reverse_iterator() NOEXCEPT {}
 
       const_reverse_iterator(
-         const NodeList<T&>& insertion_list, OrderType order_ty) NOEXCEPT: 
+         const InsertionList& insertion_list, OrderType order_ty) NOEXCEPT: 
          _const_iterator<true>(insertion_list, order_ty) {}
 
-      const_reverse_iterator(const const_reverse_iterator& other) NOEXCEPT:
-         _const_iterator<true>(other) {}
-
-      template <typename CmpTy>
-      void init_from_cmp(const _Heads<T>& heads, const CmpTy& cmp) {
-         _const_iterator<true>::_init_curr_from_cmp(heads, cmp);   
-      }
-
-      const_reverse_iterator& operator=(const const_reverse_iterator& other) 
-         NOEXCEPT {
-         _const_iterator<true>::operator=(other);   
-         return *this;
+      void init_from_head(const Head& head) {
+         _const_iterator<true>::_init_curr_from_head(head);   
       }
 
-      const_reverse_iterator operator++() NOEXCEPT {
+      const_reverse_iterator& operator++() NOEXCEPT {
          _const_iterator<true>::operator--();
          return *this;
       } 
@@ -1366,7 +1469,7 @@ public:
          return tmp;
       }
 
-      const_reverse_iterator operator--() NOEXCEPT {
+      const_reverse_iterator& operator--() NOEXCEPT {
          _const_iterator<true>::operator++();
          return *this;
       } 
@@ -1383,24 +1486,33 @@ public:
    }; 
 
 private:
+   std::tuple<Cmps...> _static_cmps;
    _Heads<T> _heads;
-   const_iterator _cend;
-   const_reverse_iterator _crend;
-   NodeList<T&> _insertion_list;
-   Index<T&> _index;
-   Extractor _get_member;
+   NodePool _pool;
+   InsertionList _insertion_list;
+   Index _index;
+   _Reassignable<Extractor> _get_member;
    size_t _size;
 
-   static AVLNode<T>* _default() {
-      return &AVLNodeDefaultSingleton().get();
+   static _Node<T>* _default() {
+      return &NodeDefaultSingleton().get();
    }
 
    static DefaultComparator<T>& _default_comparator() {
       return DefaultComparatorSingleton().get();
    }
 
-   static int dtoi(double val) {
-      std::stringstream ss;
+   template <typename CmpTy>
+   static bool _lt(const CmpTy& cmp, const T& a, const T& b) {
+      return cmp.CmpTy::lt(a, b);
+   }
+
+   static bool _lt(const Comparator& cmp, const T& a, const T& b) {
+      return cmp.lt(a, b);
+   }
+
+   static int dtoi(double val) {
+      std::stringstream ss;
       ss << val;
       int val_i;
       ss >> val_i;
@@ -1417,8 +1529,7 @@ private:
       return ss.str();
    }
 
-   template <typename U>
-   static std::string _node_data_str(AVLNode<U>* n) {
+   static std::string _node_data_str(const Node* n) {
       std::stringstream ss;
       if (n)
          ss << n->data;
@@ -1427,25 +1538,23 @@ private:
       return ss.str();
    }
 
-   template <typename U>
-   static std::string _node_str(const AVLNode<U>& n) {
+   static std::string _node_str(const Node& n, size_t slot) {
       std::stringstream ss;
       ss << "(" 
          << "data: " << n.data 
-         << ", height: " << n.height 
-         << ", left: " << _node_data_str(n.left_raw()) 
-         << ", right: " << _node_data_str(n.right_raw())
-         << ", parent: " << _node_data_str(n.parent)
+         << ", height: " << n.height(slot) 
+         << ", left: " << _node_data_str(n.left(slot)) 
+         << ", right: " << _node_data_str(n.right(slot))
+         << ", parent: " << _node_data_str(n.parent(slot))
          << ")";
       return ss.str();
    }
 
-   template <typename U>
-   static std::string _node_str(AVLNode<U>* n) {
+   static std::string _node_str(const Node* n, size_t slot) {
       std::stringstream ss;
 
       if (n)
-         return _node_str(*n);
+         return _node_str(*n, slot);
       else {
          ss << "(null)";
          return ss.str();
@@ -1456,35 +1565,24 @@ private:
       return 1ULL << (lv - 1);
    }
 
-   template <typename U>
-   AVLNodeOwner<U>& _first_child(AVLNode<U>* n) {
-      assert(n, "NullPointerError");
-      if (n->left)
-         return n->left;
-      else if (n->right)
-         return n->right;
-      else
-         assert(false, "NoChildError");
+   static int _height(const Node* tree, size_t slot) {
+      return tree ? tree->height(slot) : 0;
    }
 
-   template <typename U>
-   int _num_children(AVLNode<U>* n) {
-      int cnt = 0;
+   static size_t _subtree_size(const Node* tree, size_t slot) {
+      return tree ? tree->size(slot) : 0;
+   }
 
-      if (!n)
-         return 0;
-      if (n->left)
-         ++cnt;
-      if (n->right)
-         ++cnt;
-      return cnt;
+   static void _update_size(Node* tree, size_t slot) {
+      tree->size(slot) = _subtree_size(tree->left(slot), slot) + 
+         _subtree_size(tree->right(slot), slot) + 1;
    }
 
-   template <typename U>
-   int _height(AVLNode<U>* tree) {
-      if (!tree)
-         return 0;
-      return max(_height(tree->left_raw()), _height(tree->right_raw())) + 1;
+   static void _update_state(Node* tree, size_t slot) {
+      tree->height(slot) = max(
+         _height(tree->left(slot), slot), 
+         _height(tree->right(slot), slot)) + 1;
+      _update_size(tree, slot);
    }
 
    bool _is_too_left_heavy(int bf) {
@@ -1507,457 +1605,404 @@ private:
       return bf > 0;
    }
 
-   template <typename U>
-   int _balance_factor(AVLNode<U>* subtree) {
+   int _balance_factor(Node* subtree, size_t slot) {
       return subtree ? 
-         _height(subtree->right_raw()) - _height(subtree->left_raw()) : 0;
+         _height(subtree->right(slot), slot) - 
+            _height(subtree->left(slot), slot) : 0;
    }
 
-   template <typename U>
-   bool _is_left_left(AVLNode<U>* subtree) {
-      return _is_left_heavy(_balance_factor(subtree->left_raw()));
+   bool _is_left_left(Node* subtree, size_t slot) {
+      return _is_left_heavy(_balance_factor(subtree->left(slot), slot));
    }
 
-   template <typename U>
-   bool _is_left_right(AVLNode<U>* subtree) {
-      return _is_right_heavy(_balance_factor(subtree->left_raw()));
+   bool _is_left_right(Node* subtree, size_t slot) {
+      return _is_right_heavy(_balance_factor(subtree->left(slot), slot));
    }
 
-   template <typename U>
-   bool _is_right_right(AVLNode<U>* subtree) {
-      return _is_right_heavy(_balance_factor(subtree->right_raw()));
+   bool _is_right_right(Node* subtree, size_t slot) {
+      return _is_right_heavy(_balance_factor(subtree->right(slot), slot));
    }
 
-   template <typename U>
-   bool _is_right_left(AVLNode<U>* subtree) {
-      return _is_left_heavy(_balance_factor(subtree->right_raw()));
+   bool _is_right_left(Node* subtree, size_t slot) {
+      return _is_left_heavy(_balance_factor(subtree->right(slot), slot));
    }
 
-   template <typename U>
-   void _single_rotation_parts(
-      const AVLNodeOwner<U>& x,
-      AVLNodeOwner<U>* y, AVLNodeOwner<U>* t2, 
-      AVLNodeOwner<U>** x_owner, AVLNodeOwner<U>** t2_owner,
-      Direction y_dxn) {
+   Node** _get_owner(Node* n, Head& head) {
+      Node* parent = n->parent(head.slot);
+
+      if (parent) {
+         if (parent->left(head.slot) == n)
+            return &parent->left(head.slot);
+         else if (parent->right(head.slot) == n)
+            return &parent->right(head.slot);
+         else
+            assert(false, 
+               "ParentChildError: "
+               << std::endl
+               << "child: " << _node_str(*n, head.slot) 
+               << std::endl
+               << "parent: " << _node_str(*parent, head.slot)
+               << std::endl
+            );
+      }
+      else
+         return &head.root;
+   }
+
+   static Node* _leftest_node(Node* tree, size_t slot) {
+      while (tree->left(slot))
+         tree = tree->left(slot);
+      return tree;
+   }
+
+   Node* _single_rotation(Node** tree, size_t slot, Direction y_dxn) {
+      Node* x = *tree;
+      Node* y = nullptr;
+      Node** x_owner = nullptr;
+      Node** t2_owner = nullptr;
 
       if (y_dxn == Direction::LEFT) {
-         *y = std::move(x->left);
-         *t2 = std::move((*y)->right);
-         *x_owner = &(*y)->right;
-         *t2_owner = &x->left;
+         y = x->left(slot);
+         x->left(slot) = y->right(slot);
+         x_owner = &y->right(slot);
+         t2_owner = &x->left(slot);
       }
       else if (y_dxn == Direction::RIGHT) {
-         *y = std::move(x->right);
-         *t2 = std::move((*y)->left);
-         *x_owner = &(*y)->left;
-         *t2_owner = &x->right;
+         y = x->right(slot);
+         x->right(slot) = y->left(slot);
+         x_owner = &y->left(slot);
+         t2_owner = &x->right(slot);
       }
       else
          assert(false, "InvalidDirectionError");
-   }
 
-   template <typename U>
-   void _single_rotation_metadata_update(
-      AVLNodeOwner<U>* parent, AVLNodeOwner<U>** child) {
-      if (**child)
-         (**child)->parent = parent->get();
-      (*parent)->height = _height(parent->get());
-   }
+      if (*t2_owner)
+         (*t2_owner)->parent(slot) = x;
+      _update_state(x, slot);
 
-   template <typename U>
-   AVLNodeOwner<U>& _modify_proxy_tree(
-      AVLNodeOwner<U>* tree, const TreeEditAction<U>& edit) {
+      y->parent(slot) = x->parent(slot);
+      x->parent(slot) = y;
+      *x_owner = x;
+      _update_state(y, slot);
 
-      AVLNodeOwner<U> working_tree = std::move(*tree);
-      *tree = edit(&working_tree);
-      return *tree;
+      *tree = y;
+      return y;
    }
 
-   template <typename U>
-   AVLNodeOwner<U>& _single_rotation(
-      AVLNodeOwner<U>* tree, Direction y_dxn) {
-      return _modify_proxy_tree<U>(
-         tree, 
-         [&y_dxn, this](AVLNodeOwner<U>* x) -> AVLNodeOwner<U> {
-
-         AVLNodeOwner<U> y;
-         AVLNodeOwner<U> t2;
-         AVLNodeOwner<U>* x_owner = nullptr;
-         AVLNodeOwner<U>* t2_owner = nullptr;
-
-         _single_rotation_parts(*x, &y, &t2, &x_owner, &t2_owner, y_dxn);
-         *t2_owner = std::move(t2);
-         _single_rotation_metadata_update(x, &t2_owner);
-         *x_owner = std::move(*x); 
-         _single_rotation_metadata_update(&y, &x_owner);
-
-         return y;
-      });
-   }
+   Node* _rebalance(Node** subtree, size_t slot) {
+      Node* n = *subtree;
+      int bf = _balance_factor(n, slot);
 
-   template <typename U>
-   AVLNodeOwner<U>& _right_rotation(AVLNodeOwner<U>* subtree) {
-      return _modify_proxy_tree<U>(
-         subtree, 
-         [this](AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-            return std::move(_single_rotation(working_tree, Direction::LEFT));
-         });
+      if (_is_too_left_heavy(bf)) {
+         if (_is_left_right(n, slot))
+            _single_rotation(&n->left(slot), slot, Direction::RIGHT);
+         return _single_rotation(subtree, slot, Direction::LEFT);
+      }
+      else if (_is_too_right_heavy(bf)) {
+         if (_is_right_left(n, slot))
+            _single_rotation(&n->right(slot), slot, Direction::LEFT);
+         return _single_rotation(subtree, slot, Direction::RIGHT);
+      }
+      return n;
    }
 
-   template <typename U>
-   AVLNodeOwner<U>& _left_rotation(AVLNodeOwner<U>* subtree) {
-      return _modify_proxy_tree<U>(
-         subtree, 
-         [this](AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-            return std::move(_single_rotation(working_tree, Direction::RIGHT));
-         });
-   }
+   void _retrace(Node* n, Head& head) {
+      while (n) {
+         Node* parent = n->parent(head.slot);
+         int old_height = _height(n, head.slot);
 
-   template <typename U>
-   AVLNodeOwner<U>& _left_right_double_rotation(
-      AVLNodeOwner<U>* subtree) {
-      _modify_proxy_tree<U>(
-         &(*subtree)->left,
-         [this](AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-            return std::move(_left_rotation(working_tree));
-         });
-      return _modify_proxy_tree<U>(
-         subtree,
-         [this](AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-            return std::move(_right_rotation(working_tree));
-         });
-   }
+         _update_state(n, head.slot);
+         Node* subtree = _rebalance(_get_owner(n, head), head.slot);
+         n = parent;
+         if (_height(subtree, head.slot) == old_height)
+            break;
+      }
 
-   template <typename U>
-   AVLNodeOwner<U>& _right_left_double_rotation(
-      AVLNodeOwner<U>* subtree) {
-       _modify_proxy_tree<U>(
-         &(*subtree)->right,
-         [this](AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-            return std::move(_right_rotation(working_tree));
-         });
-      return _modify_proxy_tree<U>(
-         subtree,
-         [this](AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-            return std::move(_left_rotation(working_tree));
-         });
+      for (; n; n = n->parent(head.slot))
+         _update_size(n, head.slot);
    }
 
-   template <typename U>
-   AVLNodeOwner<U> _rebalance(AVLNodeOwner<U>* subtree) {
-      int bf = _balance_factor(subtree->get());
-
-      if (_is_too_heavy(bf)) {
-         _modify_proxy_tree<U>(
-            subtree,
-            [this, &bf](
-               AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-
-               if (_is_too_left_heavy(bf))
-                  return _is_left_right(working_tree->get()) ?
-                     std::move(
-                        _left_right_double_rotation(working_tree)) :
-                     std::move(_right_rotation(working_tree));
-               else if (_is_too_right_heavy(bf))
-                  return _is_right_left(working_tree->get()) ?
-                     std::move(
-                        _right_left_double_rotation(working_tree)) :
-                     std::move(_left_rotation(working_tree));
-               else
-                  assert(false, "InvalidHeavyStateError: "
-                     << _bfs_str_immed("\n", *working_tree));
-            }
-         );
+   template <typename CmpTy>
+   Node* _insert(Node* n, Head& head, const CmpTy& cmp) {
+      const size_t slot = head.slot;
+      Node* parent = nullptr;
+      Node** link = &head.root;
+
+      while (*link) {
+         parent = *link;
+         link = _lt(cmp, n->data, parent->data) ? 
+            &parent->left(slot) : &parent->right(slot);
       }
 
-      return std::move(*subtree);
+      n->height(slot) = 1;
+      n->size(slot) = 1;
+      n->parent(slot) = parent;
+      *link = n;
+      _retrace(parent, head);
+      return n;
    }
 
-   template <typename U>
-   AVLNodeOwner<U>& _child_insertion_side(
-      AVLNodeOwner<U>* n, 
-      AVLNodeOwner<U>* subtree, 
-      const Comparator& cmp) {
+   template <size_t I = 0>
+   typename std::enable_if<I == sizeof...(Cmps)>::type 
+   _insert_static_heads(Node*) {}
 
-      return cmp.lt((*n)->data, (*subtree)->data) ?
-         (*subtree)->left : (*subtree)->right;
+   template <size_t I = 0>
+   typename std::enable_if<I < sizeof...(Cmps)>::type 
+   _insert_static_heads(Node* n) {
+      _insert(n, *_heads.at(I + 1), std::get<I>(_static_cmps));
+      _insert_static_heads<I + 1>(n);
    }
 
-   template <typename U>
-   AVLNodeOwner<U>& _insert_recurs(
-      AVLNodeOwner<U>* n, 
-      AVLNodeOwner<U>* subtree, 
-      AVLNode<U>** result,
-      const Comparator& cmp) {
-
-      (*n)->parent = subtree->get();
-
-      AVLNodeOwner<U>& child_tree = 
-         _child_insertion_side(n, subtree, cmp);
-
-      if (child_tree) {
-         _modify_proxy_tree<U>(&child_tree,
-            [this, &n, &subtree, &result, &cmp](
-               AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-               return std::move(
-                  _insert_recurs(n, working_tree, result, cmp));
-            });
-         child_tree->parent = subtree->get();
-      }
-      else {
-         child_tree = std::move(*n);
-         *result = child_tree.get();
-      }
-
-      (*subtree)->height = _height(subtree->get());
+   void _insert_each_head(Node* n) {
+      Head* head = _primary();
+      assert(head, "InvalidHeadError");
+      _insert(n, *head, _default_comparator());
+      _insert_static_heads(n);
 
-      return _modify_proxy_tree<U>(
-         subtree,
-         [this](AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-            return _rebalance(working_tree);
-         });
+      for (
+         auto head_it = _heads.begin(1 + sizeof...(Cmps)); 
+         head_it != _heads.end(); 
+         ++head_it)
+         _insert(n, *head_it, *head_it->cmp);
    }
 
-   template <typename U>
-   AVLNode<U>* _insert(
-      AVLNodeOwner<U>* n, 
-      AVLNodeOwner<U>* head, 
-      const Comparator& cmp) {
-
-      ++(*n)->height;
+   template <size_t I = 0>
+   typename std::enable_if<I == sizeof...(Cmps)>::type 
+   _insert_static_head(Node*, size_t) {}
 
-      if (!*head) {
-         *head = std::move(*n);
-         return head->get();
-      }
-
-      AVLNode<U>* result;
-      *head = std::move(_insert_recurs(n, head, &result, cmp));
-      (*head)->parent = nullptr;
-      return result;
+   template <size_t I = 0>
+   typename std::enable_if<I < sizeof...(Cmps)>::type 
+   _insert_static_head(Node* n, size_t slot) {
+      if (slot == I + 1)
+         _insert(n, *_heads.at(slot), std::get<I>(_static_cmps));
+      else
+         _insert_static_head<I + 1>(n, slot);
    }
 
-   std::list<NodeTracker<T&>> _insert_each_head(const T& val) {
-      AVLNodeOwner<T> real_n = std::make_unique<AVLNode<T>>(val);
-      T& data = real_n->data;
-      auto head = _heads.template
-         get<_head_type::node_data>(_default_comparator());
-      assert(head, "InvalidHeadError");
-      _insert(&real_n, &head->second, head->first);
+   void _insert_into_head(Node* n, size_t slot) {
+      if (slot == 0)
+         _insert(n, *_primary(), _default_comparator());
+      else if (slot <= sizeof...(Cmps))
+         _insert_static_head(n, slot);
+      else
+         _insert(n, *_heads.at(slot), *_heads.at(slot)->cmp);
+   }
 
-      std::list<NodeTracker<T&>> rtn;
+   void _track(Node* n, IndexSlot* slot, size_t hash) {
+      ++_size;
+      _insertion_list.push_back(n);
+      _index.occupy(slot, hash, n);
+   }
 
-      for (auto head_it = _heads.begin(); head_it != _heads.end(); ++head_it) {
-         AVLNodeOwner<T&> ref_n = std::make_unique<AVLNode<T&>>(data); 
-         AVLNode<T&>* n = _insert(&ref_n, &head_it->second, head_it->first);
+   ConstResult<T&> _link(Node* n, IndexSlot* slot, size_t hash) {
+      _insert_each_head(n);
+      _track(n, slot, hash);
+      return ConstResult<T&>(n->data);
+   }
 
-         std::tuple<AVLNode<T&>*, const Comparator&, AVLNodeOwner<T&>*> p(
-            n, head_it->first, &head_it->second);
+   // Links sorted[lo, hi) as a perfectly balanced subtree of slot.
+   Node* _build_balanced(
+      const std::vector<Node*>& sorted, size_t lo, size_t hi, size_t slot, 
+      Node* parent) {
+      if (lo == hi)
+         return nullptr;
 
-         head_it->first == _default_comparator() ?
-            rtn.emplace_front(std::move(p)) :
-            rtn.emplace_back(std::move(p));
-      }
+      const size_t mid = lo + (hi - lo) / 2;
+      Node* n = sorted[mid];
+      n->parent(slot) = parent;
+      n->left(slot) = _build_balanced(sorted, lo, mid, slot, n);
+      n->right(slot) = _build_balanced(sorted, mid + 1, hi, slot, n);
+      _update_state(n, slot);
+      return n;
+   }
 
-      assert(!rtn.empty(), "EmptyListError");
-      return std::move(rtn);
+   // Stable-sorting a copy of the insertion-ordered nodes keeps equal 
+   // elements in insertion order, as repeated _insert calls would.
+   template <typename CmpTy>
+   void _build_head(
+      std::vector<Node*> sorted, Head& head, const CmpTy& cmp) {
+      std::stable_sort(sorted.begin(), sorted.end(), 
+         [this, &cmp](const Node* a, const Node* b) {
+            return _lt(cmp, a->data, b->data);
+         });
+      head.root = 
+         _build_balanced(sorted, 0, sorted.size(), head.slot, nullptr);
    }
 
-   template <typename U>
-   AVLNodeOwner<U> _on_removal_leaf(
-      AVLNodeOwner<U>* n, AVLNodeOwner<U>* rm = nullptr) {
-      assert(n, "NullPointerError");
-      assert(!(*n)->left && !(*n)->right, "NotLeafError");
+   template <size_t I = 0>
+   typename std::enable_if<I == sizeof...(Cmps)>::type 
+   _build_static_heads(const std::vector<Node*>&) {}
 
-      if (rm)
-         *rm = std::move(*n);
-      return AVLNodeOwner<U>();
+   template <size_t I = 0>
+   typename std::enable_if<I < sizeof...(Cmps)>::type 
+   _build_static_heads(const std::vector<Node*>& nodes) {
+      _build_head(nodes, *_heads.at(I + 1), std::get<I>(_static_cmps));
+      _build_static_heads<I + 1>(nodes);
    }
 
-   template <typename U>
-   AVLNodeOwner<U>& _on_removal_one_child(
-      AVLNodeOwner<U>* n, AVLNodeOwner<U>* rm = nullptr) {
-      assert(*n, "NullPointerError");
-      assert(_num_children(n->get()) == 1, "MustHaveExactlyOneChildError");
-
-      return _modify_proxy_tree<U>(n,
-         [this, &rm](
-            AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-            AVLNodeOwner<U> child = 
-               std::move(_first_child(working_tree->get()));
-
-            AVLNodeOwner<U> tmp;
-            if (!rm)
-               rm = &tmp;
-
-            *rm = std::move(*working_tree);
-
-            child->parent = (*rm)->parent;
-            (*rm)->height = _height(rm->get());
-            (*rm)->parent = nullptr;
-            (*rm)->left = nullptr;
-            (*rm)->right = nullptr;
-
-            return child;
-         }
-      );
+   void _build_each_head(const std::vector<Node*>& nodes) {
+      _build_head(nodes, *_primary(), _default_comparator());
+      _build_static_heads(nodes);
+
+      for (
+         auto head_it = _heads.begin(1 + sizeof...(Cmps)); 
+         head_it != _heads.end(); 
+         ++head_it)
+         _build_head(nodes, *head_it, *head_it->cmp);
    }
 
-   template <typename U>
-   void _transfer_to_next(AVLNodeOwner<U>* next, AVLNodeOwner<U>* temp) {
-      (*next)->left = std::move((*temp)->left);
-      (*next)->right = std::move((*temp)->right);
-      (*next)->parent = (*temp)->parent;
-      (*next)->height = (*temp)->height;   
+   template <typename InputIt>
+   void _reserve_for(InputIt, InputIt, std::input_iterator_tag) {}
 
-      if ((*next)->left)
-         (*next)->left->parent = next->get();
-      if ((*next)->right)
-         (*next)->right->parent = next->get();
+   template <typename ForwardIt>
+   void _reserve_for(
+      ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+      _index.reserve(std::distance(first, last));
    }
 
+   // Indexes a new node without linking it into any head, for callers 
+   // that update the heads themselves; null if the key is taken.
    template <typename U>
-   AVLNodeOwner<U> _rm_next_in_order(
-      AVLNodeOwner<U>* tree, AVLNodeOwner<U>* next) {
-      _modify_proxy_tree<U>(
-         tree,
-         [this, &next](
-            AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-
-            if ((*working_tree)->left) {
-               (*working_tree)->left = 
-                  std::move(_rm_next_in_order(&(*working_tree)->left, next));
-               if (*working_tree)
-                  (*working_tree)->height = _height(working_tree->get());
-               return std::move(*working_tree);
-            }
-            else {
-               if ((*working_tree)->right)
-                  return std::move(_on_removal_one_child(working_tree, next));
-               else
-                  return std::move(_on_removal_leaf(working_tree, next));
-            }
-         }
-      );
-
-      return std::move(*tree);
+   Node* _stage(U&& val) {
+      const KeyTy& key = _get_member(val);
+      const size_t hash = _hash(key);
+      IndexSlot* slot = _index.probe(hash, KeyMatch{_get_member, key});
+      if (slot->node)
+         return nullptr;
+      Node* n = _pool.create(_heads.size(), std::forward<U>(val));
+      _track(n, slot, hash);
+      return n;
    }
 
    template <typename U>
-   AVLNodeOwner<U>& _on_removal_two_children(
-      AVLNodeOwner<U>* n, AVLNodeOwner<U>* rm = nullptr) {
-      assert(n, "NullPointerError");
-
-      return  _modify_proxy_tree<U>(n, 
-         [this, &rm](
-            AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
-            AVLNodeOwner<U> next;
-            AVLNodeOwner<U> tmp;
-            if (!rm)
-               rm = &tmp;
-
-            (*working_tree)->right = 
-               _rm_next_in_order(&(*working_tree)->right, &next);
-            (*working_tree)->height = _height(working_tree->get());
-
-            _transfer_to_next(&next, working_tree);
-            *rm = std::move(*working_tree);
-            return next;
-         }
-      );
+   ConstResult<T&> _insert_value(U&& val) {
+      const KeyTy& key = _get_member(val);
+      const size_t hash = _hash(key);
+      IndexSlot* slot = _index.probe(hash, KeyMatch{_get_member, key});
+      if (slot->node)
+         return ConstResult<T&>();
+      return _link(_pool.create(_heads.size(), std::forward<U>(val)), 
+         slot, hash);
    }
 
-   template <typename U>
-   AVLNodeOwner<U> _remove_and_rebalance(
-      const T& val, AVLNodeOwner<U>* subtree, 
-      AVLNode<U>* parent, const Comparator& cmp) {
+   Node* _remove(Node* n, Head& head) {
+      const size_t slot = head.slot;
+      Node** owner = _get_owner(n, head);
+      Node* retrace_from;
 
-      AVLNodeOwner<U> rm;
+      if (n->left(slot) && n->right(slot)) {
+         Node* next = _leftest_node(n->right(slot), slot);
+         Node** next_owner = _get_owner(next, head);
 
-      _modify_proxy_tree<U>(subtree,
-         [this, &val, &cmp, &rm](
-            AVLNodeOwner<U>* working_tree) -> AVLNodeOwner<U> {
+         retrace_from = next->parent(slot) == n ? next : next->parent(slot);
+         *next_owner = next->right(slot);
+         if (*next_owner)
+            (*next_owner)->parent(slot) = next->parent(slot);
 
-            *working_tree = 
-               std::move(_remove(val, working_tree, cmp, &rm));
-            return _rebalance(working_tree);
-         });
+         next->state(slot) = n->state(slot);
 
-      if (*subtree)
-         (*subtree)->parent = parent;
+         if (next->left(slot))
+            next->left(slot)->parent(slot) = next;
+         if (next->right(slot))
+            next->right(slot)->parent(slot) = next;
+         *owner = next;
+      }
+      else {
+         *owner = n->left(slot) ? n->left(slot) : n->right(slot);
+         if (*owner)
+            (*owner)->parent(slot) = n->parent(slot);
+         retrace_from = n->parent(slot);
+      }
 
-      return rm;
+      n->state(slot) = typename Node::State();
+      _retrace(retrace_from, head);
+      return n;
    }
 
-   template <typename U>
-   AVLNodeOwner<U>& _remove(
-      const T& val, AVLNodeOwner<U>* tree, 
-      const Comparator& cmp, AVLNodeOwner<U>* rm) {
-      if (!*tree) {
-         *rm = nullptr;
-         return *tree;
-      }
-
-      if (cmp.lt(val, (*tree)->data))
-         *rm = _remove_and_rebalance(val, &(*tree)->left, tree->get(), cmp);
-      else if (cmp.gt(val, (*tree)->data))
-         *rm = _remove_and_rebalance(val, &(*tree)->right, tree->get(), cmp);
-      else {
-         if (_num_children(tree->get()) == 1)
-            *tree = std::move(_on_removal_one_child(tree, rm));
-         else if (!_num_children(tree->get()))
-            *tree = std::move(_on_removal_leaf(tree, rm));
-         else
-            *tree = std::move(_on_removal_two_children(tree, rm));
+   void _grow_nodes(size_t num_slots) {
+      NodePool pool(Node::alloc_size(num_slots));
+      const size_t new_slot = num_slots - 1;
+
+      InsertionList relocated;
+
+      for (
+         Node* old_n = _insertion_list.first; 
+         old_n; 
+         old_n = old_n->next_inserted) {
+
+         Node* n = pool.create(num_slots, std::move(old_n->data));
+         for (size_t slot = 0; slot < new_slot; ++slot)
+            n->state(slot) = old_n->state(slot);
+         n->parent(new_slot) = old_n;
+         old_n->parent(0) = n;
+         relocated.push_back(n);
+      }
+
+      auto moved = [](Node* old_n) -> Node* {
+         return old_n ? old_n->parent(0) : nullptr;
+      };
+
+      for (Node* n = relocated.first; n; n = n->next_inserted) {
+         for (size_t slot = 0; slot < new_slot; ++slot) {
+            n->left(slot) = moved(n->left(slot));
+            n->right(slot) = moved(n->right(slot));
+            n->parent(slot) = moved(n->parent(slot));
+         }
       }
 
-      if (*tree)
-         (*tree)->height = _height(tree->get());
-      return *tree;
+      Head* head = _primary();
+      head->root = moved(head->root);
+      for (auto head_it = _heads.begin(); head_it != _heads.end(); ++head_it)
+         head_it->root = moved(head_it->root);
+      _index.for_each([&moved](IndexSlot& slot) { 
+         slot.node = moved(slot.node); 
+      });
+
+      for (Node* n = relocated.first; n; n = n->next_inserted) {
+         _pool.destroy(n->parent(new_slot));
+         n->state(new_slot) = typename Node::State();
+      }
+      _pool = std::move(pool);
+      _insertion_list = std::move(relocated);
    }
 
-   template <typename U>
-   bool _is_dq_all_nulls(const NodeDQ<U>& dq) const {
+   bool _is_dq_all_nulls(const NodeDQ& dq) const {
       auto it = find_if(
          dq.begin(), dq.end(), 
-            [](AVLNode<U>* n) -> bool { return n != nullptr; });
+            [](Node* n) -> bool { return n != nullptr; });
       return it == dq.end();
    }
 
-   template <typename U>
-   void _on_max_nodes_per_line(NodeDQ<U>* dq, const VoidFunc& func) const {
+   void _on_max_nodes_per_line(NodeDQ* dq, const VoidFunc& func) const {
       func();
       if (_is_dq_all_nulls(*dq))
          dq->clear();
    }
 
-   template <typename U>
    void _on_valid_node(
-      NodeDQ<U>* dq, AVLNode<U>* n, const NodeListener<U>& func) const {
+      NodeDQ* dq, Node* n, size_t slot, const NodeListener& func) const {
       func(n);
-      dq->push_back(n->left_raw());
-      dq->push_back(n->right_raw());
+      dq->push_back(n->left(slot));
+      dq->push_back(n->right(slot));
    }
 
-   template <typename U>
-   void _on_null_node(NodeDQ<U>* dq, const NodeListener<U>& func) const {
+   void _on_null_node(NodeDQ* dq, const NodeListener& func) const {
       func(nullptr);
       dq->push_back(nullptr);
       dq->push_back(nullptr);
    }
 
-   template <typename U>
-   void _gather_bfs(NodeDQ<U>* dq, size_t* curr_depth,
-      size_t* node_cnt, const NodeListener<U>& func) const {
+   void _gather_bfs(NodeDQ* dq, size_t slot, size_t* curr_depth,
+      size_t* node_cnt, const NodeListener& func) const {
 
       if (dq->empty()) 
          return;
 
-      AVLNode<U>* n = dq->front();
+      Node* n = dq->front();
       dq->pop_front();
 
       if (n) 
-         _on_valid_node(dq, n, func);
+         _on_valid_node(dq, n, slot, func);
       else 
          _on_null_node(dq, func);
 
@@ -1967,36 +2012,34 @@ private:
             ++*curr_depth;
          });
 
-      _gather_bfs(dq, curr_depth, node_cnt, func);
+      _gather_bfs(dq, slot, curr_depth, node_cnt, func);
    }
 
-   template <typename U>
-   NodeList<U> _gather_bfs_list(const AVLNodeOwner<U>& root) const {
-      NodeDQ<U> dq;
-      NodeList<U> nl;
+   NodeList _gather_bfs_list(Node* root, size_t slot) const {
+      NodeDQ dq;
+      NodeList nl;
       size_t curr_depth = 1;
       size_t node_cnt = 0;
 
       if (root)
-         dq.push_back(root.get());
+         dq.push_back(root);
 
-      _gather_bfs<U>(&dq, &curr_depth, &node_cnt,
-         [&nl](AVLNode<U>* n) { nl.push_back(n); });
+      _gather_bfs(&dq, slot, &curr_depth, &node_cnt,
+         [&nl](Node* n) { nl.push_back(n); });
       return nl;
    }
 
-   template <typename U>
    std::string _gather_bfs_str(
-      const std::string& delim, const AVLNodeOwner<U>& root) const {
-      NodeList<U> nl = _gather_bfs_list<U>(root);
+      const std::string& delim, Node* root, size_t slot) const {
+      NodeList nl = _gather_bfs_list(root, slot);
       std::stringstream ss;
       int node_cnt = 0;
       int curr_depth = 1;
 
       for (auto nit = nl.begin(); nit != nl.end(); ++nit) {
-         AVLNode<U>* n = *nit;
+         Node* n = *nit;
          bool last_node = ++node_cnt == _nodes_at_lv(curr_depth);
-         ss << (n ? _node_str(*n) : "(null)") << (last_node ? "" : " ");
+         ss << _node_str(n, slot) << (last_node ? "" : " ");
 
          if (last_node) {
             if (nit != prev(nl.end()))
@@ -2013,247 +2056,1000 @@ private:
       const std::string& delim = "|",
       const CmpTy& cmp=_default_comparator()) const {
 
-      auto head = _heads.template get<_head_type::node_ref>(cmp);
-      return _gather_bfs_str<T&>(delim, head->second);
+      const Head* head = _find_head(cmp);
+      return _gather_bfs_str(delim, head->root, head->slot);
    }
 
-   template <typename U>
    std::string _bfs_str_immed(
-      const std::string& delim, const AVLNodeOwner<U>& subtree) const {
-      return _gather_bfs_str<U>(delim, subtree);
+      const std::string& delim, Node* subtree, size_t slot) const {
+      return _gather_bfs_str(delim, subtree, slot);
    }
 
-   template <typename U>
-   std::string _bfs_str_immed(
-      const AVLNodeOwner<U>& subtree) const {
-      return _gather_bfs_str<U>("|", subtree);
+   std::string _bfs_str_immed(Node* subtree, size_t slot) const {
+      return _gather_bfs_str("|", subtree, slot);
    }
 
    std::string _index_str(const std::string& delim = "|") const {
       std::stringstream ss;
-      for (auto it = _index.begin(); it != _index.end(); ++it) {
-         AVLNode<T&>* n = std::get<0>(it->second.front());
-         ss << it->first << ": "<< _node_str(*n) << delim;
-      }
+      _index.for_each([this, &ss, &delim](const IndexSlot& slot) {
+         ss << _get_member(slot.node->data) << ": "
+            << _node_str(*slot.node, 0) << delim;
+      });
       return ss.str();
    }
 
-   _Heads<T> _init_heads() {
-      _Heads<T> heads;
-      heads.push(_default_comparator());
-      heads.push(_default_comparator());
-      return heads;
+   size_t _hash(const KeyTy& key) const {
+      return std::hash<KeyTy>()(key);
    }
 
-   template <typename U>
-   AVLNodeOwner<U>* _get_owner(AVLNode<U>* n, AVLNodeOwner<U>* root) {
-      if (n->parent) {
-         if (n->parent->left.get() == n)
-            return &n->parent->left;
-         else if (n->parent->right.get() == n)
-            return &n->parent->right;
+   const IndexSlot* _find_slot(const KeyTy& key) const {
+      return _index.find(_hash(key), KeyMatch{_get_member, key});
+   }
+
+   IndexSlot* _find_slot(const KeyTy& key) {
+      return _index.find(_hash(key), KeyMatch{_get_member, key});
+   }
+
+   Result<T> _remove_slot(IndexSlot* slot) {
+      if (!slot)
+         return Result<T>();
+
+      Node* n = slot->node;
+      _remove(n, *_primary());
+      for (auto head_it = _heads.begin(); head_it != _heads.end(); ++head_it)
+         _remove(n, *head_it);
+      return _release(slot);
+   }
+
+   // Drops a node that is already unlinked from every head.
+   Result<T> _release(IndexSlot* slot) {
+      Node* n = slot->node;
+      _insertion_list.erase(n);
+      _index.erase(slot);
+
+      Result<T> res(std::move(n->data));
+      _pool.destroy(n);
+      --_size;
+      return res;
+   }
+
+   Head* _primary() {
+      return _heads.primary();
+   }
+
+   // A comparator whose type is one of Cmps... only needs comparing with 
+   // the head at that type's fixed slot. One with different state may 
+   // still have a runtime head, so it falls back to scanning the registry.
+   template <typename CmpTy>
+   static constexpr size_t _static_slot() {
+      return _type_index<CmpTy, DefaultComparator<T>, Cmps...>::value;
+   }
+
+   template <typename CmpTy>
+   const Head* _find_head(const CmpTy& cmp) const {
+      const size_t slot = _static_slot<CmpTy>();
+      if (slot <= sizeof...(Cmps) && cmp == *_heads.at(slot)->cmp)
+         return _heads.at(slot);
+      return _heads.find(cmp);
+   }
+
+   template <typename CmpTy>
+   Head* _find_head(const CmpTy& cmp) {
+      return const_cast<Head*>(
+         static_cast<const BasicVindex*>(this)->_find_head(cmp));
+   }
+
+   template <typename CmpTy>
+   const_iterator _bound(
+      const T& probe, const CmpTy& cmp, bool upper) const {
+      const Head* head = &_registered_head(cmp);
+      Node* bound = nullptr;
+      Node* n = head->root;
+
+      while (n) {
+         if (upper ? _lt(cmp, probe, n->data) : !_lt(cmp, n->data, probe)) {
+            bound = n;
+            n = n->left(head->slot);
+         }
          else
-            assert(false, 
-               "ParentChildError: "
-               << std::endl
-               << "child: " << _node_str(*n) 
-               << std::endl
-               << "parent: " << _node_str(*n->parent)
-               << std::endl
-            );
+            n = n->right(head->slot);
       }
-      else
-         return root;
-   }
 
-   template <typename U>
-   void _remove_and_rebalance_iteratively(
-      AVLNode<U>* n, const Comparator& cmp, AVLNodeOwner<U>* root) {
-      AVLNodeOwner<U>* owner = _get_owner(n, root);
-      AVLNode<U>* next_node = n->parent;
+      if (!bound)
+         return const_iterator();
+
+      const_iterator it(_insertion_list, OrderType::INORDER);
+      it.init_at_node(*head, bound);
+      return it;
+   }
 
-      _remove_and_rebalance<U>(n->data, owner, n->parent, cmp);
+   // Reads never register comparators, so concurrent readers share the 
+   // tree without locking; registration is opt-in via push_comparator().
+   template <typename CmpTy>
+   const Head& _registered_head(const CmpTy& cmp) const {
+      const Head* head = _find_head(cmp);
+      if (!head)
+         throw std::invalid_argument("ComparatorNotRegisteredError");
+      return *head;
+   }
 
-      while (next_node) {
-         AVLNode<U>* parent = next_node->parent;
-         AVLNodeOwner<U>* subtree = _get_owner(next_node, root);
-         *subtree = _rebalance(subtree);
-         (*subtree)->height = _height(subtree->get());
-         (*subtree)->parent = parent;
-         next_node = parent;
+   template <typename CmpTy>
+   size_t _rank(const T& probe, const Head& head, const CmpTy& cmp, 
+      bool upper) const {
+      size_t rank = 0;
+      Node* n = head.root;
+
+      while (n) {
+         if (upper ? _lt(cmp, probe, n->data) : !_lt(cmp, n->data, probe))
+            n = n->left(head.slot);
+         else {
+            rank += _subtree_size(n->left(head.slot), head.slot) + 1;
+            n = n->right(head.slot);
+         }
       }
+      return rank;
+   }
+
+   template <size_t I = 0>
+   typename std::enable_if<I == sizeof...(Cmps)>::type 
+   _push_static_cmps(_Heads<T>*) {}
+
+   template <size_t I = 0>
+   typename std::enable_if<I < sizeof...(Cmps)>::type 
+   _push_static_cmps(_Heads<T>* heads) {
+      heads->push(std::get<I>(_static_cmps));
+      _push_static_cmps<I + 1>(heads);
+   }
+
+   _Heads<T> _init_heads() {
+      _Heads<T> heads;
+      heads.push(_default_comparator());
+      _push_static_cmps(&heads);
+      return heads;
    }
 
 public:
-   Vindex(const Extractor& get_member) NOEXCEPT: 
+   BasicVindex(const Extractor& get_member) NOEXCEPT: 
+      BasicVindex(get_member, std::tuple<Cmps...>())
+      {}
+
+   BasicVindex(const Extractor& get_member, const std::tuple<Cmps...>& cmps) 
+      NOEXCEPT: 
+      _static_cmps(cmps),
       _heads(_init_heads()),
+      _pool(Node::alloc_size(_heads.size())),
       _get_member(get_member),
       _size(0)
       {}
 
-   Vindex(Vindex&& other) NOEXCEPT: 
-      _get_member(std::move(other._get_member)),
+   // Builds each node's copy at the same pool slab and offset as the 
+   // original, so every link, the key index and the insertion list are 
+   // remapped by address and nothing is rehashed or rebalanced. Still 
+   // O(n): every element is copied.
+   BasicVindex(const BasicVindex& other): 
+      _static_cmps(other._static_cmps),
+      _heads(other._heads),
+      _pool(Node::alloc_size(_heads.size())),
+      _get_member(other._get_member),
+      _size(other._size) {
+      _pool.mirror(other._pool);
+      const typename NodePool::Relocation moved(other._pool, _pool);
+
+      for (Node* n = other._insertion_list.first; n; n = n->next_inserted) {
+         Node* copy = new (moved(n)) Node(_heads.size(), n->data);
+         copy->prev_inserted = moved(n->prev_inserted);
+         copy->next_inserted = moved(n->next_inserted);
+         for (size_t slot = 0; slot < _heads.size(); ++slot) {
+            copy->height(slot) = n->height(slot);
+            copy->size(slot) = n->size(slot);
+            copy->left(slot) = moved(n->left(slot));
+            copy->right(slot) = moved(n->right(slot));
+            copy->parent(slot) = moved(n->parent(slot));
+         }
+      }
+      _insertion_list.first = moved(other._insertion_list.first);
+      _insertion_list.last = moved(other._insertion_list.last);
+      _index.assign(other._index, moved);
+
+      for (size_t slot = 0; slot < _heads.size(); ++slot)
+         _heads.at(slot)->root = moved(other._heads.at(slot)->root);
+   }
+
+   BasicVindex(BasicVindex&& other) NOEXCEPT: 
+      _static_cmps(std::move(other._static_cmps)),
       _heads(std::move(other._heads)),
+      _pool(std::move(other._pool)),
       _insertion_list(std::move(other._insertion_list)),
       _index(std::move(other._index)),
-      _size(std::move(other._size)), 
-      _cend(std::move(other._cend)),
-      _crend(std::move(other._crend)) 
-      {}
+      _get_member(std::move(other._get_member)),
+      _size(other._size) {
+      other._size = 0;
+   }
 
-   Vindex& operator=(Vindex&& other) NOEXCEPT {
-      _get_member = std::move(other._get_member);
+   ~BasicVindex() {
+      clear();
+   }
+
+   BasicVindex& operator=(BasicVindex&& other) NOEXCEPT {
+      if (this == &other)
+         return *this;
+      clear();
+      _static_cmps = std::move(other._static_cmps);
       _heads = std::move(other._heads);
+      _pool = std::move(other._pool);
       _insertion_list = std::move(other._insertion_list);
       _index = std::move(other._index);
-      _size = std::move(other._size);
-      _cend = std::move(other._cend);
-      _crend = std::move(other._crend);
+      _get_member = std::move(other._get_member);
+      _size = other._size;
+      other._size = 0;
       return *this;
    }
 
+   // Every node is reallocated to make room for the new head's links, so 
+   // this invalidates all references, ConstResults and iterators into the 
+   // vindex. Comparators passed as Cmps... have no such cost.
    template <typename ComparatorTy>
    void push_comparator(const ComparatorTy& cmp) NOEXCEPT {
       static_assert(std::is_base_of<IComparator<T>, ComparatorTy>::value,
          "ComparatorTy must be derived from IComparator<T>");
-      if (_heads.exists(cmp))
+      if (_find_head(cmp))
          return;
       _heads.push(cmp);
-      auto head = _heads.template get<_head_type::node_ref>(cmp);
+      Head* head = _heads.find(cmp);
       assert(head, "NullPointerError");
 
-      for (
-         auto it = _insertion_list.begin(); 
-         it != _insertion_list.end(); 
-         ++it) {
-
-         AVLNodeOwner<T&> n = std::make_unique<AVLNode<T&>>((*it)->data);
-         AVLNode<T&>* np = _insert(&n, &head->second, head->first);
-         _index.at(_get_member(np->data)).emplace_back(
-            np, head->first, &head->second);
-      }
+      _grow_nodes(_heads.size());
+      for (Node* n = _insertion_list.first; n; n = n->next_inserted)
+         _insert(n, *head, cmp);
    }
 
    ConstResult<T&> insert(const T& val) NOEXCEPT {
-      if (_index.find(_get_member(val)) != _index.end())
-         return std::make_unique<ConstResultFailure<T&>>();
-      std::list<NodeTracker<T&>> nodes = _insert_each_head(val);
-      assert(!nodes.empty(), "EmptyListError");
-      ++_size;
-      AVLNode<T&>* default_n = std::get<0>(nodes.front());
-      _insertion_list.emplace_back(default_n);
-      _index[_get_member(default_n->data)] = std::move(nodes);
-      return std::make_unique<ConstResultSuccess<T&>>(default_n->data);
+      return _insert_value(val);
+   }
+
+   ConstResult<T&> insert(T&& val) NOEXCEPT {
+      return _insert_value(std::move(val));
    }
 
    template <typename... Args>
    ConstResult<T&> emplace(Args&&... args) NOEXCEPT {
-      return insert(T(std::forward<Args>(args)...));
+      Node* n = _pool.create(_heads.size(), std::forward<Args>(args)...);
+      const KeyTy& key = _get_member(n->data);
+      const size_t hash = _hash(key);
+      IndexSlot* slot = _index.probe(hash, KeyMatch{_get_member, key});
+      if (slot->node) {
+         _pool.destroy(n);
+         return ConstResult<T&>();
+      }
+      return _link(n, slot, hash);
    }
 
    Result<T> remove(const T& val) NOEXCEPT {
-      const KeyTy& key = _get_member(val);
-
-      if (!_index.count(key))
-         return std::make_unique<ResultFailure<T>>();
-
-      for (auto& node_tracker : _index.at(key)) {
-         AVLNode<T&>* n = std::get<0>(node_tracker);
-         const Comparator& cmp = std::get<1>(node_tracker);
-         AVLNodeOwner<T&>* root = std::get<2>(node_tracker);
-
-         _remove_and_rebalance_iteratively<T&>(n, cmp, root);
-
-         if (cmp == _default_comparator())
-            _insertion_list.remove(n);
-      }
-      _index.erase(key);
-
-      auto head = _heads.template
-         get<_head_type::node_data>(_default_comparator());
-      AVLNodeOwner<T> rm =
-          _remove_and_rebalance<T>(val, &head->second, nullptr, head->first);
-
-      assert(rm, "NullPointerError");
-      --_size;
-      return std::make_unique<ResultSuccess<T>>(rm->data);
+      return _remove_slot(_find_slot(_get_member(val)));
    }
 
    Result<T> remove(const KeyTy& key) NOEXCEPT {
-      try {
-         const T& val = at(key);
-         Result<T> res = remove(val);
-         assert(dynamic_cast<ResultSuccess<T>*>(res.get()) != nullptr, 
-            "NullPointerError");
-         return std::move(res);
-      }
-      catch (std::out_of_range&) {
-         return std::make_unique<ResultFailure<T>>();
-      }
+      return _remove_slot(_find_slot(key));
    }
 
    template <typename CmpTy=DefaultComparator<T>> 
    const_iterator cbegin(
-      OrderType order_ty, const CmpTy& cmp=_default_comparator()) NOEXCEPT {
-      if (!_heads.exists(cmp))
-         push_comparator(cmp);
-
+      OrderType order_ty, const CmpTy& cmp=_default_comparator()) const {
       const_iterator it(_insertion_list, order_ty);
-      it.init_from_cmp(_heads, cmp);
-      _cend = it.end();
+      it.init_from_head(_registered_head(cmp));
       return it;
    }
 
-   const_iterator cend() NOEXCEPT {
-      return _cend;
+   const_iterator cend() const NOEXCEPT {
+      return const_iterator();
    }
 
    template <typename CmpTy=DefaultComparator<T>>
    const_reverse_iterator crbegin(
-      OrderType order_ty, const CmpTy& cmp=_default_comparator()) NOEXCEPT {
-      if (!_heads.exists(cmp))
-         push_comparator(cmp);
-
+      OrderType order_ty, const CmpTy& cmp=_default_comparator()) const {
       const_reverse_iterator it(_insertion_list, order_ty);
-      it.init_from_cmp(_heads, cmp);
-      _crend = it.end();
+      it.init_from_head(_registered_head(cmp));
       return it;
    }
 
-   const_reverse_iterator crend() NOEXCEPT {
-      return _crend;
+   const_reverse_iterator crend() const NOEXCEPT {
+      return const_reverse_iterator();
    }
 
    template <typename CmpTy=DefaultComparator<T>>
    const_iterator find(
       const KeyTy& key,
       OrderType order_ty, 
-      const CmpTy& cmp=_default_comparator()) NOEXCEPT {
+      const CmpTy& cmp=_default_comparator()) const {
 
-      auto it = cbegin(order_ty, cmp);
-      return std::find_if(it, cend(), [this, key](const T& elem) -> bool {
-         return key == _get_member(elem);
-      });
+      const Head* head = &_registered_head(cmp);
+      const IndexSlot* slot = _find_slot(key);
+      if (!slot)
+         return const_iterator();
+
+      const_iterator it(_insertion_list, order_ty);
+      it.init_at_node(*head, slot->node);
+      return it;
+   }
+
+   template <typename CmpTy=DefaultComparator<T>>
+   const_iterator lower_bound(
+      const T& probe, const CmpTy& cmp=_default_comparator()) const {
+      return _bound(probe, cmp, /*upper=*/false);
+   }
+
+   template <typename CmpTy=DefaultComparator<T>>
+   const_iterator upper_bound(
+      const T& probe, const CmpTy& cmp=_default_comparator()) const {
+      return _bound(probe, cmp, /*upper=*/true);
+   }
+
+   template <typename CmpTy=DefaultComparator<T>>
+   std::pair<const_iterator, const_iterator> equal_range(
+      const T& probe, const CmpTy& cmp=_default_comparator()) const {
+      return std::make_pair(
+         lower_bound(probe, cmp), upper_bound(probe, cmp));
+   }
+
+   template <typename CmpTy=DefaultComparator<T>>
+   size_t rank(
+      const T& probe, const CmpTy& cmp=_default_comparator()) const {
+      return _rank(probe, _registered_head(cmp), cmp, /*upper=*/false);
+   }
+
+   template <typename CmpTy=DefaultComparator<T>>
+   const_iterator select(
+      size_t k, const CmpTy& cmp=_default_comparator()) const {
+      const Head* head = &_registered_head(cmp);
+      Node* n = head->root;
+
+      while (n) {
+         size_t left_size = 
+            _subtree_size(n->left(head->slot), head->slot);
+         if (k < left_size)
+            n = n->left(head->slot);
+         else if (k == left_size)
+            break;
+         else {
+            k -= left_size + 1;
+            n = n->right(head->slot);
+         }
+      }
+
+      if (!n)
+         return const_iterator();
+
+      const_iterator it(_insertion_list, OrderType::INORDER);
+      it.init_at_node(*head, n);
+      return it;
+   }
+
+   template <typename CmpTy=DefaultComparator<T>>
+   size_t count_range(
+      const T& lo, const T& hi, 
+      const CmpTy& cmp=_default_comparator()) const {
+      const Head* head = &_registered_head(cmp);
+      size_t lo_rank = _rank(lo, *head, cmp, /*upper=*/false);
+      size_t hi_rank = _rank(hi, *head, cmp, /*upper=*/false);
+      return hi_rank > lo_rank ? hi_rank - lo_rank : 0;
    }
 
    const T& at(const KeyTy& key) const {
-      return std::get<0>(_index.at(key).front())->data;
+      const IndexSlot* slot = _find_slot(key);
+      if (!slot)
+         throw std::out_of_range("KeyNotFoundError");
+      return slot->node->data;
+   }
+
+   void reserve(size_t size) NOEXCEPT {
+      _index.reserve(size);
+   }
+
+   // Replaces the contents with [first, last), keeping the first element 
+   // of each key like insert() would. Each head is sorted once and built 
+   // balanced bottom-up instead of being rebalanced per element.
+   template <typename InputIt>
+   void assign(InputIt first, InputIt last) {
+      clear();
+      _reserve_for(first, last, 
+         typename std::iterator_traits<InputIt>::iterator_category());
+
+      std::vector<Node*> nodes;
+      for (; first != last; ++first) {
+         Node* n = _stage(*first);
+         if (n)
+            nodes.push_back(n);
+      }
+      _build_each_head(nodes);
    }
 
-   size_t size() NOEXCEPT {
+   size_t size() const NOEXCEPT {
       return _size;
    }
 
    void clear() NOEXCEPT {
+      if (!std::is_trivially_destructible<T>::value)
+         for (Node* n = _insertion_list.first; n; n = n->next_inserted)
+            n->~Node();
       _insertion_list.clear();
       _index.clear();
-      auto head = _heads.template
-         get<_head_type::node_data>(_default_comparator());
+
+      Head* head = _primary();
+      if (head)
+         head->root = nullptr;
       for (auto head_it = _heads.begin(); head_it != _heads.end(); ++head_it)
-         head_it->second = nullptr;
-      head->second = nullptr;
+         head_it->root = nullptr;
+      _pool.release();
       _size = 0;
    }
+
+   NodePoolStats pool_stats() const NOEXCEPT {
+      return _pool.stats();
+   }
+};
+
+// Builds a BasicVindex whose extractor is a template parameter, so key
+// extraction is a direct (inlinable) call and may return const KeyTy&.
+template <typename T, typename... Cmps, typename ExtractorTy>
+BasicVindex<
+   typename std::decay<
+      decltype(std::declval<const ExtractorTy&>()(std::declval<const T&>()))
+   >::type, 
+   T, ExtractorTy, Cmps...> 
+basic_vindex(const ExtractorTy& get_member) {
+   return BasicVindex<
+      typename std::decay<
+         decltype(
+            std::declval<const ExtractorTy&>()(std::declval<const T&>()))
+      >::type, 
+      T, ExtractorTy, Cmps...>(get_member);
+}
+
+template <typename VindexTy>
+class ConcurrentVindex;
+
+// Reader-writer facade over a BasicVindex: reads share the lock, writes 
+// (including push_comparator) take it exclusively. Results are returned 
+// by value, since references into the vindex would outlive the lock; use 
+// read() and write() to run anything else under the appropriate lock.
+//
+// snapshot() returns an immutable copy that is scanned without any lock. 
+// Writers never copy: the copy is made by the first snapshot() after a 
+// write and shared by later ones while any of them is held. Only a weak 
+// reference is kept here, so each version is freed when its last 
+// snapshot is dropped. Every new version is a full O(n) copy.
+template <
+   typename KeyTy, typename T, typename ExtractorTy, typename... Cmps>
+class ConcurrentVindex<BasicVindex<KeyTy, T, ExtractorTy, Cmps...>> {
+public:
+   typedef BasicVindex<KeyTy, T, ExtractorTy, Cmps...> Vindex;
+   typedef std::shared_ptr<const Vindex> Snapshot;
+
+private:
+   typedef std::lock_guard<_SharedMutex> _ExclusiveLock;
+
+   mutable _SharedMutex _mutex;
+   Vindex _vin;
+
+   mutable std::mutex _publish_mutex;
+   mutable std::weak_ptr<const Vindex> _published;
+   mutable bool _dirty;
+
+   Vindex& _writable() {
+      _dirty = true;
+      return _vin;
+   }
+
+public:
+   explicit ConcurrentVindex(const ExtractorTy& get_member): 
+      _vin(get_member), 
+      _dirty(true) 
+      {}
+
+   explicit ConcurrentVindex(Vindex&& vin): 
+      _vin(std::move(vin)), 
+      _dirty(true) 
+      {}
+
+   ConcurrentVindex(const ConcurrentVindex&) = delete;
+   ConcurrentVindex& operator=(const ConcurrentVindex&) = delete;
+
+   // Copies the whole vindex under the shared lock. A writer arriving 
+   // after a write blocks for that O(n) copy, but not for scans of the 
+   // snapshot. Take snapshots for long scans, not per lookup.
+   Snapshot snapshot() const {
+      std::lock_guard<std::mutex> publish_lock(_publish_mutex);
+      _SharedLock lock(_mutex);
+      Snapshot snap = _published.lock();
+      if (_dirty || !snap) {
+         snap = std::make_shared<const Vindex>(_vin);
+         _published = snap;
+         _dirty = false;
+      }
+      return snap;
+   }
+
+   template <typename Fn>
+   auto read(Fn fn) const -> decltype(fn(std::declval<const Vindex&>())) {
+      _SharedLock lock(_mutex);
+      return fn(_vin);
+   }
+
+   template <typename Fn>
+   auto write(Fn fn) -> decltype(fn(std::declval<Vindex&>())) {
+      _ExclusiveLock lock(_mutex);
+      return fn(_writable());
+   }
+
+   template <typename ComparatorTy>
+   void push_comparator(const ComparatorTy& cmp) {
+      _ExclusiveLock lock(_mutex);
+      _writable().push_comparator(cmp);
+   }
+
+   bool insert(const T& val) {
+      _ExclusiveLock lock(_mutex);
+      return static_cast<bool>(_writable().insert(val));
+   }
+
+   bool insert(T&& val) {
+      _ExclusiveLock lock(_mutex);
+      return static_cast<bool>(_writable().insert(std::move(val)));
+   }
+
+   template <typename... Args>
+   bool emplace(Args&&... args) {
+      _ExclusiveLock lock(_mutex);
+      return static_cast<bool>(
+         _writable().emplace(std::forward<Args>(args)...));
+   }
+
+   Result<T> remove(const KeyTy& key) {
+      _ExclusiveLock lock(_mutex);
+      return _writable().remove(key);
+   }
+
+   void reserve(size_t size) {
+      _ExclusiveLock lock(_mutex);
+      _vin.reserve(size);
+   }
+
+   void clear() {
+      _ExclusiveLock lock(_mutex);
+      _writable().clear();
+   }
+
+   T at(const KeyTy& key) const {
+      _SharedLock lock(_mutex);
+      return _vin.at(key);
+   }
+
+   size_t size() const {
+      _SharedLock lock(_mutex);
+      return _vin.size();
+   }
+
+   // Holds the shared lock for the whole traversal.
+   template <typename Fn, typename CmpTy=DefaultComparator<T>>
+   void for_each(
+      OrderType::OrderType order_ty, Fn fn, const CmpTy& cmp=CmpTy()) const {
+      _SharedLock lock(_mutex);
+      for (auto it = _vin.cbegin(order_ty, cmp); it != _vin.cend(); ++it)
+         fn(*it);
+   }
+};
+
+template <typename VindexTy>
+class ShardedVindex;
+
+// Partitions elements over independently locked vindexes by key hash, so 
+// point operations on different shards do not contend. Scans hold every 
+// shard's shared lock, taken in shard order. INORDER scans merge the 
+// shards' iterators with a heap.
+template <
+   typename KeyTy, typename T, typename ExtractorTy, typename... Cmps>
+class ShardedVindex<BasicVindex<KeyTy, T, ExtractorTy, Cmps...>> {
+public:
+   typedef BasicVindex<KeyTy, T, ExtractorTy, Cmps...> Vindex;
+
+private:
+   typedef std::lock_guard<_SharedMutex> _ExclusiveLock;
+   typedef typename Vindex::const_iterator VindexIter;
+
+   struct Shard {
+      mutable _SharedMutex mutex;
+      Vindex vin;
+
+      explicit Shard(const ExtractorTy& get_member): vin(get_member) {}
+   };
+
+   class _ReadAll {
+   private:
+      const std::vector<std::unique_ptr<Shard>>& _shards;
+
+   public:
+      explicit _ReadAll(const std::vector<std::unique_ptr<Shard>>& shards): 
+         _shards(shards) {
+         for (size_t i = 0; i < _shards.size(); ++i)
+            _shards[i]->mutex.lock_shared();
+      }
+
+      ~_ReadAll() {
+         for (size_t i = _shards.size(); i > 0; --i)
+            _shards[i - 1]->mutex.unlock_shared();
+      }
+
+      _ReadAll(const _ReadAll&) = delete;
+      _ReadAll& operator=(const _ReadAll&) = delete;
+   };
+
+   std::vector<std::unique_ptr<Shard>> _shards;
+   ExtractorTy _get_member;
+
+   Shard& _shard_of(const KeyTy& key) const {
+      return *_shards[std::hash<KeyTy>()(key) % _shards.size()];
+   }
+
+   static size_t _default_shards() {
+      size_t cores = std::thread::hardware_concurrency();
+      return cores ? cores : 1;
+   }
+
+public:
+   explicit ShardedVindex(
+      const ExtractorTy& get_member, size_t num_shards=_default_shards()): 
+      _get_member(get_member) {
+      assert(num_shards > 0, "InvalidArgumentError");
+      for (size_t i = 0; i < num_shards; ++i)
+         _shards.emplace_back(std::make_unique<Shard>(get_member));
+   }
+
+   ShardedVindex(const ShardedVindex&) = delete;
+   ShardedVindex& operator=(const ShardedVindex&) = delete;
+
+   template <typename ComparatorTy>
+   void push_comparator(const ComparatorTy& cmp) {
+      for (size_t i = 0; i < _shards.size(); ++i) {
+         _ExclusiveLock lock(_shards[i]->mutex);
+         _shards[i]->vin.push_comparator(cmp);
+      }
+   }
+
+   bool insert(const T& val) {
+      Shard& shard = _shard_of(_get_member(val));
+      _ExclusiveLock lock(shard.mutex);
+      return static_cast<bool>(shard.vin.insert(val));
+   }
+
+   bool insert(T&& val) {
+      Shard& shard = _shard_of(_get_member(val));
+      _ExclusiveLock lock(shard.mutex);
+      return static_cast<bool>(shard.vin.insert(std::move(val)));
+   }
+
+   // The key is only known once T exists, so T is built before routing 
+   // and moved into its shard.
+   template <typename... Args>
+   bool emplace(Args&&... args) {
+      return insert(T(std::forward<Args>(args)...));
+   }
+
+   Result<T> remove(const KeyTy& key) {
+      Shard& shard = _shard_of(key);
+      _ExclusiveLock lock(shard.mutex);
+      return shard.vin.remove(key);
+   }
+
+   void reserve(size_t size) {
+      for (size_t i = 0; i < _shards.size(); ++i) {
+         _ExclusiveLock lock(_shards[i]->mutex);
+         _shards[i]->vin.reserve(size / _shards.size() + 1);
+      }
+   }
+
+   void clear() {
+      for (size_t i = 0; i < _shards.size(); ++i) {
+         _ExclusiveLock lock(_shards[i]->mutex);
+         _shards[i]->vin.clear();
+      }
+   }
+
+   T at(const KeyTy& key) const {
+      Shard& shard = _shard_of(key);
+      _SharedLock lock(shard.mutex);
+      return shard.vin.at(key);
+   }
+
+   size_t size() const {
+      _ReadAll lock(_shards);
+      size_t size = 0;
+      for (size_t i = 0; i < _shards.size(); ++i)
+         size += _shards[i]->vin.size();
+      return size;
+   }
+
+   size_t num_shards() const {
+      return _shards.size();
+   }
+
+   // INORDER visits every element in ascending cmp order across all 
+   // shards. Other orders have no meaning across shards, so each shard is 
+   // traversed in turn.
+   template <typename Fn, typename CmpTy=DefaultComparator<T>>
+   void for_each(
+      OrderType::OrderType order_ty, Fn fn, const CmpTy& cmp=CmpTy()) const {
+      _ReadAll lock(_shards);
+
+      if (order_ty != OrderType::INORDER) {
+         for (size_t i = 0; i < _shards.size(); ++i) {
+            const Vindex& vin = _shards[i]->vin;
+            for (auto it = vin.cbegin(order_ty, cmp); it != vin.cend(); ++it)
+               fn(*it);
+         }
+         return;
+      }
+
+      std::vector<std::pair<VindexIter, VindexIter>> runs;
+      runs.reserve(_shards.size());
+      for (size_t i = 0; i < _shards.size(); ++i) {
+         const Vindex& vin = _shards[i]->vin;
+         VindexIter it = vin.cbegin(OrderType::INORDER, cmp);
+         if (it != vin.cend())
+            runs.emplace_back(it, vin.cend());
+      }
+
+      auto later = [&runs, &cmp](size_t a, size_t b) -> bool {
+         return Vindex::_lt(cmp, *runs[b].first, *runs[a].first);
+      };
+
+      std::vector<size_t> heap;
+      heap.reserve(runs.size());
+      for (size_t i = 0; i < runs.size(); ++i)
+         heap.push_back(i);
+      std::make_heap(heap.begin(), heap.end(), later);
+
+      while (!heap.empty()) {
+         std::pop_heap(heap.begin(), heap.end(), later);
+         std::pair<VindexIter, VindexIter>& run = runs[heap.back()];
+         fn(*run.first);
+         if (++run.first != run.second)
+            std::push_heap(heap.begin(), heap.end(), later);
+         else
+            heap.pop_back();
+      }
+   }
+};
+
+// Fixed set of threads that run fn(0) .. fn(count - 1) for one job at a 
+// time. The calling thread claims indices too, so a pool with no threads 
+// runs jobs inline.
+class _WorkerPool {
+private:
+   typedef std::function<void(size_t)> Job;
+
+   std::vector<std::thread> _threads;
+   std::mutex _mutex;
+   std::condition_variable _work_cv;
+   std::condition_variable _done_cv;
+   const Job* _job;
+   size_t _next;
+   size_t _count;
+   size_t _done;
+   bool _stop;
+
+   // Runs claimed indices until none are left; expects lock to be held.
+   void _drain(std::unique_lock<std::mutex>& lock) {
+      while (_next < _count) {
+         const Job& job = *_job;
+         size_t i = _next++;
+         lock.unlock();
+         job(i);
+         lock.lock();
+         if (++_done == _count)
+            _done_cv.notify_all();
+      }
+   }
+
+   void _work() {
+      std::unique_lock<std::mutex> lock(_mutex);
+      for (;;) {
+         _work_cv.wait(lock, [this]() { return _stop || _next < _count; });
+         if (_stop)
+            return;
+         _drain(lock);
+      }
+   }
+
+public:
+   explicit _WorkerPool(size_t num_threads): 
+      _job(nullptr), _next(0), _count(0), _done(0), _stop(false) {
+      for (size_t i = 0; i < num_threads; ++i)
+         _threads.emplace_back(&_WorkerPool::_work, this);
+   }
+
+   ~_WorkerPool() {
+      {
+         std::lock_guard<std::mutex> lock(_mutex);
+         _stop = true;
+      }
+      _work_cv.notify_all();
+      for (size_t i = 0; i < _threads.size(); ++i)
+         _threads[i].join();
+   }
+
+   _WorkerPool(const _WorkerPool&) = delete;
+   _WorkerPool& operator=(const _WorkerPool&) = delete;
+
+   // Not reentrant: callers must not run jobs concurrently.
+   void run(size_t count, const Job& job) {
+      if (_threads.empty() || count < 2) {
+         for (size_t i = 0; i < count; ++i)
+            job(i);
+         return;
+      }
+
+      std::unique_lock<std::mutex> lock(_mutex);
+      _job = &job;
+      _next = _done = 0;
+      _count = count;
+      _work_cv.notify_all();
+
+      _drain(lock);
+      _done_cv.wait(lock, [this]() { return _done == _count; });
+      _job = nullptr;
+      _next = _count = _done = 0;
+   }
+};
+
+template <typename VindexTy>
+class ParallelVindex;
+
+// Gives every head its own lock and updates the heads of one mutation in 
+// parallel on a worker pool. Writers are serialized; a reader of one 
+// order waits only while a write is updating that order's head. The key 
+// index and insertion list share a separate lock, which guards at(), 
+// size() and INSERTION scans.
+template <
+   typename KeyTy, typename T, typename ExtractorTy, typename... Cmps>
+class ParallelVindex<BasicVindex<KeyTy, T, ExtractorTy, Cmps...>> {
+public:
+   typedef BasicVindex<KeyTy, T, ExtractorTy, Cmps...> Vindex;
+
+private:
+   typedef std::lock_guard<_SharedMutex> _ExclusiveLock;
+   typedef typename Vindex::Node Node;
+
+   // Lock order: _registry_mutex, _writer_mutex, _index_mutex, then heads. 
+   // push_comparator() relocates every node, so all access holds 
+   // _registry_mutex.
+   mutable _SharedMutex _registry_mutex;
+   std::mutex _writer_mutex;
+   mutable _SharedMutex _index_mutex;
+   std::vector<std::unique_ptr<_SharedMutex>> _head_mutexes;
+   Vindex _vin;
+   _WorkerPool _pool;
+
+   // With fewer heads, handing them to the pool costs more than updating 
+   // them in turn. Not tuned: only measured on a single core.
+   static const size_t _min_parallel_heads = 4;
+
+   template <typename Fn>
+   void _each_head(const Fn& fn) {
+      auto locked = [this, &fn](size_t slot) {
+         _ExclusiveLock lock(*_head_mutexes[slot]);
+         fn(slot);
+      };
+      if (_head_mutexes.size() < _min_parallel_heads) {
+         for (size_t slot = 0; slot < _head_mutexes.size(); ++slot)
+            locked(slot);
+         return;
+      }
+      _pool.run(_head_mutexes.size(), locked);
+   }
+
+   template <typename U>
+   bool _insert(U&& val) {
+      _SharedLock registry_lock(_registry_mutex);
+      std::lock_guard<std::mutex> writer_lock(_writer_mutex);
+      Node* n = nullptr;
+      {
+         _ExclusiveLock lock(_index_mutex);
+         n = _vin._stage(std::forward<U>(val));
+      }
+      if (!n)
+         return false;
+
+      _each_head([this, n](size_t slot) { _vin._insert_into_head(n, slot); });
+      return true;
+   }
+
+   // A single core gets no workers, so heads are updated inline; an 
+   // explicit num_workers is used as given.
+   static size_t _default_workers() {
+      size_t cores = std::thread::hardware_concurrency();
+      return cores > 1 ? cores - 1 : 0;
+   }
+
+public:
+   explicit ParallelVindex(
+      const ExtractorTy& get_member, size_t num_workers=_default_workers()): 
+      _vin(get_member),
+      _pool(num_workers) {
+      for (size_t slot = 0; slot < 1 + sizeof...(Cmps); ++slot)
+         _head_mutexes.emplace_back(std::make_unique<_SharedMutex>());
+   }
+
+   ParallelVindex(const ParallelVindex&) = delete;
+   ParallelVindex& operator=(const ParallelVindex&) = delete;
+
+   template <typename ComparatorTy>
+   void push_comparator(const ComparatorTy& cmp) {
+      _ExclusiveLock lock(_registry_mutex);
+      _vin.push_comparator(cmp);
+      while (_head_mutexes.size() < _vin._heads.size())
+         _head_mutexes.emplace_back(std::make_unique<_SharedMutex>());
+   }
+
+   bool insert(const T& val) {
+      return _insert(val);
+   }
+
+   bool insert(T&& val) {
+      return _insert(std::move(val));
+   }
+
+   template <typename... Args>
+   bool emplace(Args&&... args) {
+      return _insert(T(std::forward<Args>(args)...));
+   }
+
+   Result<T> remove(const KeyTy& key) {
+      _SharedLock registry_lock(_registry_mutex);
+      std::lock_guard<std::mutex> writer_lock(_writer_mutex);
+      auto slot = _vin._find_slot(key);
+      if (!slot)
+         return Result<T>();
+
+      Node* n = slot->node;
+      _each_head([this, n](size_t slot) {
+         _vin._remove(n, *_vin._heads.at(slot));
+      });
+
+      _ExclusiveLock lock(_index_mutex);
+      return _vin._release(slot);
+   }
+
+   void reserve(size_t size) {
+      _SharedLock registry_lock(_registry_mutex);
+      std::lock_guard<std::mutex> writer_lock(_writer_mutex);
+      _ExclusiveLock lock(_index_mutex);
+      _vin.reserve(size);
+   }
+
+   T at(const KeyTy& key) const {
+      _SharedLock registry_lock(_registry_mutex);
+      _SharedLock lock(_index_mutex);
+      return _vin.at(key);
+   }
+
+   size_t size() const {
+      _SharedLock registry_lock(_registry_mutex);
+      _SharedLock lock(_index_mutex);
+      return _vin.size();
+   }
+
+   // Holds the shared lock of the head being walked, or of the index for 
+   // INSERTION order.
+   template <typename Fn, typename CmpTy=DefaultComparator<T>>
+   void for_each(
+      OrderType::OrderType order_ty, Fn fn, const CmpTy& cmp=CmpTy()) const {
+      _SharedLock registry_lock(_registry_mutex);
+      _SharedMutex& mutex = order_ty == OrderType::INSERTION ? 
+         _index_mutex : *_head_mutexes[_vin._registered_head(cmp).slot];
+      _SharedLock lock(mutex);
+      for (auto it = _vin.cbegin(order_ty, cmp); it != _vin.cend(); ++it)
+         fn(*it);
+   }
 };
 
 #pragma pop_macro("NDEBUG")